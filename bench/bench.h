@@ -0,0 +1,143 @@
+#ifndef _IV_BENCH_BENCH_H_
+#define _IV_BENCH_BENCH_H_
+#include <sys/time.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "noncopyable.h"
+namespace iv {
+namespace bench {
+
+class Timer {
+ public:
+  Timer() : start_(Now()) { }
+  inline void Reset() {
+    start_ = Now();
+  }
+  // elapsed milliseconds
+  inline double Elapsed() const {
+    return Now() - start_;
+  }
+  static double Now() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+  }
+ private:
+  double start_;
+};
+
+class Result {
+ public:
+  Result(const std::string& name, std::size_t iterations,
+         std::size_t units, const char* unit, double ms)
+    : name_(name),
+      iterations_(iterations),
+      units_(units),
+      unit_(unit),
+      ms_(ms) {
+  }
+  inline const std::string& name() const {
+    return name_;
+  }
+  inline std::size_t iterations() const {
+    return iterations_;
+  }
+  inline std::size_t units() const {
+    return units_;
+  }
+  inline const char* unit() const {
+    return unit_;
+  }
+  inline double ms() const {
+    return ms_;
+  }
+  // units per second
+  inline double throughput() const {
+    return (ms_ > 0) ? (units_ * 1000.0 / ms_) : 0;
+  }
+ private:
+  std::string name_;
+  std::size_t iterations_;
+  std::size_t units_;
+  const char* unit_;
+  double ms_;
+};
+
+// each benchmark body reports the processed units (bytes, tokens, ops)
+// of one iteration and the harness repeats it until minimum millis elapsed
+class Benchmark : private core::Noncopyable<Benchmark>::type {
+ public:
+  typedef std::size_t (*Body)();
+  static const std::size_t kWarmUp = 1;
+
+  Benchmark(const char* name, const char* unit, Body body)
+    : name_(name),
+      unit_(unit),
+      body_(body) {
+    Registry().push_back(this);
+  }
+
+  Result Run(double minimum) const {
+    for (std::size_t i = 0; i < kWarmUp; ++i) {
+      (*body_)();
+    }
+    std::size_t iterations = 0;
+    std::size_t units = 0;
+    const Timer timer;
+    double elapsed = 0;
+    do {
+      units += (*body_)();
+      ++iterations;
+      elapsed = timer.Elapsed();
+    } while (elapsed < minimum);
+    return Result(name_, iterations, units, unit_, elapsed);
+  }
+
+  inline const char* name() const {
+    return name_;
+  }
+
+  static std::vector<const Benchmark*>& Registry() {
+    static std::vector<const Benchmark*> registry;
+    return registry;
+  }
+
+ private:
+  const char* name_;
+  const char* unit_;
+  Body body_;
+};
+
+inline void WriteJSON(std::FILE* out, const std::vector<Result>& results) {
+  std::fputs("{\"micro\":[", out);
+  for (std::vector<Result>::const_iterator it = results.begin(),
+       last = results.end(); it != last; ++it) {
+    if (it != results.begin()) {
+      std::fputc(',', out);
+    }
+    std::fprintf(out,
+                 "\n{\"name\":\"%s\",\"iterations\":%lu,"
+                 "\"ms\":%.3f,\"unit\":\"%s\",\"throughput\":%.3f}",
+                 it->name().c_str(),
+                 static_cast<unsigned long>(it->iterations()),  // NOLINT
+                 it->ms(),
+                 it->unit(),
+                 it->throughput());
+  }
+  std::fputs("\n]}\n", out);
+}
+
+} }  // namespace iv::bench
+
+#define IV_BENCH_CONCAT_I(a, b) a##b
+#define IV_BENCH_CONCAT(a, b) IV_BENCH_CONCAT_I(a, b)
+
+// BENCH(name, unit) { ...; return processed_units; }
+#define BENCH(name, unit)\
+  static std::size_t IV_BENCH_CONCAT(BenchBody_, name)();\
+  static const iv::bench::Benchmark IV_BENCH_CONCAT(bench_, name)(\
+      #name, unit, &IV_BENCH_CONCAT(BenchBody_, name));\
+  static std::size_t IV_BENCH_CONCAT(BenchBody_, name)()
+
+#endif  // _IV_BENCH_BENCH_H_
@@ -0,0 +1,69 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "dtoa.h"
+#include "conversions.h"
+#include "stringpiece.h"
+#include "xorshift.h"
+
+namespace {
+
+static const std::size_t kNumbers = 10000;
+
+const std::vector<double>& Numbers() {
+  static std::vector<double> numbers;
+  if (numbers.empty()) {
+    iv::core::Xor128 random(17);
+    for (std::size_t i = 0; i < kNumbers; ++i) {
+      // mix of integers, fractions and large exponents
+      const double base = static_cast<double>(random()) / 3.0;
+      switch (i % 3) {
+        case 0:
+          numbers.push_back(static_cast<double>(random() % 100000));
+          break;
+        case 1:
+          numbers.push_back(base);
+          break;
+        default:
+          numbers.push_back(base * 1e200);
+          break;
+      }
+    }
+  }
+  return numbers;
+}
+
+const std::vector<std::string>& Strings() {
+  static std::vector<std::string> strings;
+  if (strings.empty()) {
+    char buf[80];
+    const std::vector<double>& numbers = Numbers();
+    for (std::vector<double>::const_iterator it = numbers.begin(),
+         last = numbers.end(); it != last; ++it) {
+      strings.push_back(iv::core::DoubleToCString(*it, buf, 80));
+    }
+  }
+  return strings;
+}
+
+}  // namespace anonymous
+
+BENCH(DoubleToCString, "conversions") {
+  char buf[80];
+  const std::vector<double>& numbers = Numbers();
+  for (std::vector<double>::const_iterator it = numbers.begin(),
+       last = numbers.end(); it != last; ++it) {
+    iv::core::DoubleToCString(*it, buf, 80);
+  }
+  return numbers.size();
+}
+
+BENCH(StringToDouble, "conversions") {
+  const std::vector<std::string>& strings = Strings();
+  for (std::vector<std::string>::const_iterator it = strings.begin(),
+       last = strings.end(); it != last; ++it) {
+    iv::core::StringToDouble(*it, false);
+  }
+  return strings.size();
+}
@@ -0,0 +1,79 @@
+#include <string>
+#include "bench.h"
+#include "alloc.h"
+#include "ast.h"
+#include "ast_factory.h"
+#include "lexer.h"
+#include "parser.h"
+#include "keyword.h"
+#include "icu/source.h"
+namespace {
+
+class Factory
+  : public iv::core::Space<2>,
+    public iv::core::ast::BasicAstFactory<Factory> {
+ public:
+  Factory()
+    : iv::core::Space<2>(),
+      iv::core::ast::BasicAstFactory<Factory>() {
+  }
+};
+
+// large synthetic program, about 256KB
+const std::string& LargeSource() {
+  static std::string source;
+  if (source.empty()) {
+    static const char* const kChunk =
+        "function Point(x, y) {\n"
+        "  this.x = x;\n"
+        "  this.y = y;\n"
+        "}\n"
+        "Point.prototype.distance = function(other) {\n"
+        "  var dx = this.x - other.x, dy = this.y - other.y;\n"
+        "  return Math.sqrt(dx * dx + dy * dy);\n"
+        "};\n"
+        "var table = { 'name': \"point\", value: 0x1F, list: [1, 2.5, 3e10] };\n"
+        "for (var i = 0; i < 100; ++i) {\n"
+        "  if (i % 3 === 0 && table.value !== null) {\n"
+        "    table.value += i;  // comment\n"
+        "  } else {\n"
+        "    /* block comment */ table.list[i & 1] = i > 10 ? 'a' : 'b';\n"
+        "  }\n"
+        "}\n"
+        "switch (table.name) {\n"
+        "  case 'point': break;\n"
+        "  default: table.name = typeof table;\n"
+        "}\n";
+    while (source.size() < 256 * 1024) {
+      source.append(kChunk);
+    }
+  }
+  return source;
+}
+
+const iv::icu::Source& LargeUSource() {
+  static const iv::icu::Source src(LargeSource(), "bench");
+  return src;
+}
+
+}  // namespace anonymous
+
+BENCH(Lexer, "bytes") {
+  typedef iv::core::Lexer<iv::icu::Source> Lexer;
+  const iv::icu::Source& src = LargeUSource();
+  Lexer lexer(&src);
+  iv::core::Token::Type token;
+  do {
+    token = lexer.Next<iv::core::IdentifyReservedWords>(false);
+  } while (token != iv::core::Token::EOS &&
+           token != iv::core::Token::ILLEGAL);
+  return src.size();
+}
+
+BENCH(Parser, "bytes") {
+  const iv::icu::Source& src = LargeUSource();
+  Factory factory;
+  iv::core::Parser<Factory, iv::icu::Source> parser(&factory, &src);
+  parser.ParseProgram();
+  return src.size();
+}
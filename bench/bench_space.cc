@@ -0,0 +1,36 @@
+#include "bench.h"
+#include "alloc.h"
+#include "xorshift.h"
+
+namespace {
+
+static const std::size_t kAllocations = 100000;
+
+}  // namespace anonymous
+
+BENCH(SpaceSmall, "allocations") {
+  iv::core::Space<2> space;
+  for (std::size_t i = 0; i < kAllocations; ++i) {
+    space.New(8 + (i % 8) * 8);
+  }
+  return kAllocations;
+}
+
+BENCH(SpaceMixed, "allocations") {
+  iv::core::Space<2> space;
+  iv::core::Xor128 random(17);
+  for (std::size_t i = 0; i < kAllocations; ++i) {
+    // about 3% of requests exceed the small object threshold
+    space.New(random() % 300 + 1);
+  }
+  return kAllocations;
+}
+
+BENCH(SpaceClearReuse, "allocations") {
+  static iv::core::Space<2> space;
+  for (std::size_t i = 0; i < kAllocations; ++i) {
+    space.New(32);
+  }
+  space.Clear();
+  return kAllocations;
+}
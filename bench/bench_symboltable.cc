@@ -0,0 +1,73 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "stringpiece.h"
+#include "symboltable.h"
+
+namespace {
+
+static const std::size_t kNames = 4096;
+
+void MakeNames(const char* prefix, std::vector<std::string>* names) {
+  char buf[32];
+  for (std::size_t i = 0; i < kNames; ++i) {
+    std::snprintf(buf, sizeof(buf), "%s%lu",
+                  prefix, static_cast<unsigned long>(i));  // NOLINT
+    names->push_back(buf);
+  }
+}
+
+const std::vector<std::string>& Names() {
+  static std::vector<std::string> names;
+  if (names.empty()) {
+    MakeNames("identifier", &names);
+  }
+  return names;
+}
+
+// names that are never interned into the table
+const std::vector<std::string>& MissingNames() {
+  static std::vector<std::string> names;
+  if (names.empty()) {
+    MakeNames("missing", &names);
+  }
+  return names;
+}
+
+iv::lv5::SymbolTable* FilledTable() {
+  static iv::lv5::SymbolTable table;
+  static bool filled = false;
+  if (!filled) {
+    const std::vector<std::string>& names = Names();
+    for (std::vector<std::string>::const_iterator it = names.begin(),
+         last = names.end(); it != last; ++it) {
+      table.Lookup(iv::core::StringPiece(*it));
+    }
+    filled = true;
+  }
+  return &table;
+}
+
+}  // namespace anonymous
+
+BENCH(SymbolTableLookupHit, "lookups") {
+  iv::lv5::SymbolTable* table = FilledTable();
+  const std::vector<std::string>& names = Names();
+  for (std::vector<std::string>::const_iterator it = names.begin(),
+       last = names.end(); it != last; ++it) {
+    table->Lookup(iv::core::StringPiece(*it));
+  }
+  return names.size();
+}
+
+BENCH(SymbolTableLookupMiss, "lookups") {
+  const iv::lv5::SymbolTable* table = FilledTable();
+  const std::vector<std::string>& names = MissingNames();
+  iv::lv5::Symbol sym;
+  for (std::vector<std::string>::const_iterator it = names.begin(),
+       last = names.end(); it != last; ++it) {
+    table->Find(iv::core::StringPiece(*it), &sym);
+  }
+  return names.size();
+}
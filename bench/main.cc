@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <iostream>  // NOLINT
+#include "cmdline.h"
+#include "bench.h"
+
+int main(int argc, char **argv) {
+  using iv::bench::Benchmark;
+  using iv::bench::Result;
+  iv::cmdline::Parser cmd("benchmark");
+
+  cmd.Add("help",
+          "help",
+          'h', "print this message");
+  cmd.Add<std::string>("filter",
+                       "filter",
+                       'f', "run benchmarks whose name contains this",
+                       false, "");
+  cmd.Add<int>("time",
+               "time",
+               't', "minimum milliseconds per benchmark",
+               false, 500, iv::cmdline::range(1, 60000));
+  cmd.Add<std::string>("output",
+                       "output",
+                       'o', "write JSON result to this file",
+                       false, "");
+
+  if (!cmd.Parse(argc, argv)) {
+    std::cerr << cmd.error() << std::endl << cmd.usage();
+    return EXIT_FAILURE;
+  }
+
+  if (cmd.Exist("help")) {
+    std::cout << cmd.usage();
+    return EXIT_SUCCESS;
+  }
+
+  const std::string& filter = cmd.get<std::string>("filter");
+  const double minimum = cmd.get<int>("time");
+  std::vector<Result> results;
+  const std::vector<const Benchmark*>& registry = Benchmark::Registry();
+  for (std::vector<const Benchmark*>::const_iterator it = registry.begin(),
+       last = registry.end(); it != last; ++it) {
+    if (std::string((*it)->name()).find(filter) == std::string::npos) {
+      continue;
+    }
+    const Result result = (*it)->Run(minimum);
+    std::fprintf(stderr, "%-24s %12.1f %s/s\n",
+                 result.name().c_str(), result.throughput(), result.unit());
+    results.push_back(result);
+  }
+
+  const std::string& output = cmd.get<std::string>("output");
+  if (output.empty()) {
+    iv::bench::WriteJSON(stdout, results);
+  } else if (std::FILE* fp = std::fopen(output.c_str(), "w")) {
+    iv::bench::WriteJSON(fp, results);
+    std::fclose(fp);
+  } else {
+    std::perror(output.c_str());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
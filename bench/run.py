@@ -0,0 +1,57 @@
+# -*- coding: utf-8 -*-
+# run micro benchmarks and lv5 end-to-end suites, then merge results
+# into one JSON document
+#   python bench/run.py BENCHMARK LV5 OUTPUT [SUITE.js ...]
+import sys
+import os
+import time
+import json
+import subprocess
+
+REPEAT = 5
+
+def RunMicro(benchmark):
+  proc = subprocess.Popen([benchmark], stdout=subprocess.PIPE)
+  out = proc.communicate()[0]
+  if proc.returncode != 0:
+    raise Exception('%s failed' % benchmark)
+  return json.loads(out.decode('utf-8'))['micro']
+
+def RunSuite(lv5, suite):
+  times = []
+  for i in range(REPEAT):
+    start = time.time()
+    code = subprocess.call([lv5, suite])
+    times.append((time.time() - start) * 1000.0)
+    if code != 0:
+      raise Exception('%s failed' % suite)
+  times.sort()
+  return {
+    'name': os.path.splitext(os.path.basename(suite))[0],
+    'repeat': REPEAT,
+    'min': times[0],
+    'median': times[len(times) // 2],
+    'max': times[-1]
+  }
+
+def Main(argv):
+  if len(argv) < 4:
+    sys.stderr.write(
+        'usage: run.py BENCHMARK LV5 OUTPUT [SUITE.js ...]\n')
+    return 1
+  benchmark, lv5, output = argv[1:4]
+  result = {
+    'micro': RunMicro(benchmark),
+    'suites': [RunSuite(lv5, suite) for suite in sorted(argv[4:])]
+  }
+  for suite in result['suites']:
+    sys.stderr.write('%-24s %12.1f ms\n' % (suite['name'], suite['median']))
+  f = open(output, 'w')
+  try:
+    json.dump(result, f, indent=2, sort_keys=True)
+  finally:
+    f.close()
+  return 0
+
+if __name__ == '__main__':
+  sys.exit(Main(sys.argv))
@@ -33,175 +33,179 @@ class Malloced {
   }
 };
 
-class Pool {
+// Chunk
+// contiguous memory region allocated by bump pointer
+class Chunk {
  public:
-  static const unsigned int kPoolSize = Size::KB * 4;
-  inline void Initialize(uintptr_t start, Pool* next) {
-    start_ = start;
-    position_ = start;
-    limit_ = start + Pool::kPoolSize + 1;
-    next_ = next;
-  }
-  Pool* Next() const { return next_; }
-  inline void* New(uintptr_t size) {
-    if ((position_ + size) < limit_) {
-      // in this pool
-      uintptr_t result = position_;
+  static const uintptr_t kAlignment = 8;
+
+  inline void Initialize(uintptr_t start, std::size_t size) {
+    start_ = AlignOffset(start, kAlignment);
+    position_ = start_;
+    limit_ = start + size;
+    next_ = NULL;
+  }
+
+  inline void* New(std::size_t size) {
+    if (size <= (limit_ - position_)) {
+      // in this chunk
+      const uintptr_t result = position_;
       position_ += size;
       return reinterpret_cast<void*>(result);
     }
     return NULL;
   }
+
+  // rewind bump pointer, all memory in this chunk becomes available again
+  inline void Reset() {
+    position_ = start_;
+  }
+
+  inline std::size_t capacity() const {
+    return limit_ - start_;
+  }
+
+  inline void set_next(Chunk* next) { next_ = next; }
+  inline Chunk* next() const { return next_; }
+
+  // allocate Chunk header + size bytes from Upstream allocator
+  template<typename Upstream>
+  static Chunk* Allocate(std::size_t size) {
+    const std::size_t header = AlignOffset(sizeof(Chunk), kAlignment);
+    void* const mem = Upstream::New(header + size);
+    Chunk* const chunk = new(mem)Chunk();
+    chunk->Initialize(reinterpret_cast<uintptr_t>(mem) + header, size);
+    return chunk;
+  }
+
+  template<typename Upstream>
+  static void Release(Chunk* chunk) {
+    chunk->~Chunk();
+    Upstream::Delete(chunk);
+  }
+
  private:
   uintptr_t start_;
   uintptr_t position_;
   uintptr_t limit_;
-  Pool* next_;
+  Chunk* next_;
 };
 
-class Arena {
+// Arena
+// Chunk with inline storage, Space has N Arenas and uses them before
+// requesting memory from upstream allocator
+class Arena : public Chunk {
  public:
-  static const unsigned int kPoolNum = 64;
-  static const uintptr_t kAlignment = 8;
-  static const unsigned int kArenaSize = (Pool::kPoolSize * kPoolNum) +
-                                ((Pool::kPoolSize <= kAlignment) ?
-                                  0 : (Pool::kPoolSize - kAlignment));
-  Arena()
-    : pools_(),
-      result_(),
-      now_(&pools_[0]),
-      start_(now_),
-      next_(NULL) {
-    uintptr_t address = reinterpret_cast<uintptr_t>(result_);
-
-    uintptr_t pool_address = AlignOffset(address, Pool::kPoolSize);
-    unsigned int c = 0;
-    for (; c < kPoolNum-1; ++c) {
-      pools_[c].Initialize(pool_address+c*Pool::kPoolSize, &pools_[c+1]);
-    }
-    pools_[kPoolNum-1].Initialize(
-        pool_address+(kPoolNum-1)*Pool::kPoolSize, NULL);
+  static const std::size_t kArenaSize = Size::KB * 256;
+  Arena() {
+    Initialize(reinterpret_cast<uintptr_t>(buffer_), kArenaSize);
   }
-
-  inline void* New(std::size_t raw_size) {
-    uintptr_t size = AlignOffset(raw_size, kAlignment);
-    void* result = now_->New(size);
-    if (result == NULL) {
-      now_ = now_->Next();
-      while (now_) {
-        result = now_->New(size);
-        if (result == NULL) {
-          now_ = now_->Next();
-        } else {
-          return result;
-        }
-      }
-      return NULL;  // full up
-    }
-    return result;
-  }
-  inline void SetNext(Arena* next) { next_ = next; }
-  inline Arena* Next() const { return next_; }
  private:
-  Pool pools_[kPoolNum];
-  char result_[kArenaSize];
-  Pool* now_;
-  const Pool* start_;
-  Arena* next_;
+  char buffer_[kArenaSize];
 };
 
-template<std::size_t N>
+// Space
+// arena allocator for AST and other objects that are released together.
+// small objects are allocated from N inline Arenas and then from Chunks
+// whose size grows geometrically. objects larger than kThreshold are
+// allocated as a dedicated Chunk. Clear rewinds all Chunks and releases
+// large objects, so Space can be reused.
+//
+// Upstream must provide static New(std::size_t) and Delete(void*),
+// Malloced is the default.
+template<std::size_t N, typename Upstream = Malloced>
 class Space {
  public:
   Space()
-    : arena_(&init_arenas_[0]),
-      start_malloced_(NULL),
-      malloced_() {
-    for (std::size_t c = 0; c < N-1; ++c) {
-      init_arenas_[c].SetNext(&init_arenas_[c+1]);
+    : current_(&init_arenas_[0]),
+      last_(&init_arenas_[N-1]),
+      next_chunk_size_(Arena::kArenaSize * 2),
+      large_(NULL),
+      upstream_size_(0) {
+    for (std::size_t c = 1; c < N; ++c) {
+      init_arenas_[c-1].set_next(&init_arenas_[c]);
     }
   }
+
   ~Space() {
-    if (start_malloced_) {
-      Arena *now = start_malloced_, *next = start_malloced_;
-      while (now) {
-        next = now->Next();
-        delete now;
-        now = next;
-      }
+    ReleaseLarge();
+    Chunk* chunk = init_arenas_[N-1].next();
+    while (chunk) {
+      Chunk* const next = chunk->next();
+      Chunk::Release<Upstream>(chunk);
+      chunk = next;
     }
-    std::for_each(malloced_.begin(), malloced_.end(), &Malloced::Delete);
   }
-  inline void* New(std::size_t size) {
+
+  inline void* New(std::size_t raw_size) {
+    const std::size_t size = AlignOffset(raw_size, Chunk::kAlignment);
     if ((size - 1) < kThreshold) {
       // small memory allocator
-      void* result = arena_->New(size);
-      if (result == NULL) {
-        Arena *arena = arena_->Next();
-        if (arena) {
-          arena_ = arena;
-        } else {
-          NewArena();
-          if (!start_malloced_) {
-            start_malloced_ = arena_;
-          }
-        }
-        result = arena_->New(size);
-        if (result == NULL) {
-          Malloced::OutOfMemory();
+      void* result = current_->New(size);
+      while (result == NULL) {
+        if (current_ == last_) {
+          NewChunk();
         }
+        current_ = current_->next();
+        result = current_->New(size);
       }
       return result;
     } else {
-      // malloc as memory allocator
-      void* result = Malloced::New(size);
-      malloced_.push_back(result);
-      return result;
+      // dedicated chunk for large object
+      Chunk* const chunk = Chunk::Allocate<Upstream>(size);
+      upstream_size_ += size;
+      chunk->set_next(large_);
+      large_ = chunk;
+      return chunk->New(size);
     }
   }
 
+  // release large objects and rewind all chunks.
+  // memory of chunks is retained and reused by next allocations.
   inline void Clear() {
-    arena_ = init_arenas_;
-    std::for_each(malloced_.begin(), malloced_.end(), &Malloced::Delete);
-    malloced_.clear();
+    ReleaseLarge();
+    for (Chunk* chunk = &init_arenas_[0]; chunk; chunk = chunk->next()) {
+      chunk->Reset();
+    }
+    current_ = &init_arenas_[0];
+  }
+
+  // bytes held from Upstream, inline Arenas are not included
+  inline std::size_t upstream_size() const {
+    return upstream_size_;
   }
 
  private:
   static const std::size_t kThreshold = 256;
-  static const std::size_t kInitArenas = N;
-
-  inline Arena* NewArena() {
-    Arena* arena = NULL;
-    try {
-      arena = new Arena();
-      if (arena == NULL) {
-        Malloced::OutOfMemory();
-        return arena;
-      }
-    } catch(const std::bad_alloc&) {
-      Malloced::OutOfMemory();
-      return arena;
+  static const std::size_t kMaxChunkSize = Size::MB * 4;
+
+  // append chunk to the tail of chunk list, chunk size grows geometrically
+  inline void NewChunk() {
+    Chunk* const chunk = Chunk::Allocate<Upstream>(next_chunk_size_);
+    last_->set_next(chunk);
+    last_ = chunk;
+    upstream_size_ += next_chunk_size_;
+    if (next_chunk_size_ < kMaxChunkSize) {
+      next_chunk_size_ *= 2;
     }
-    arena_->SetNext(arena);
-    arena_ = arena;
-    return arena;
   }
-  inline const std::vector<void*>& malloced() const {
-    return malloced_;
+
+  inline void ReleaseLarge() {
+    while (large_) {
+      Chunk* const next = large_->next();
+      upstream_size_ -= large_->capacity();
+      Chunk::Release<Upstream>(large_);
+      large_ = next;
+    }
   }
-  Arena init_arenas_[kInitArenas];
-  Arena* arena_;
-  Arena* start_malloced_;
-  std::vector<void*>malloced_;
-};
 
-// surpress compiler warning
-template<>
-inline Space<1>::Space()
-  : arena_(&init_arenas_[0]),
-    start_malloced_(NULL),
-    malloced_() {
-}
+  Arena init_arenas_[N];
+  Chunk* current_;
+  Chunk* last_;
+  std::size_t next_chunk_size_;
+  Chunk* large_;
+  std::size_t upstream_size_;
+};
 
 } }  // namespace iv::core
 #endif  // _IV_ALLOC_H_
@@ -73,7 +73,8 @@ class Scope : private Noncopyable<Scope<Factory> >::type {
   explicit Scope(Factory* factory)
     : up_(NULL),
       vars_(typename Variables::allocator_type(factory)),
-      funcs_(typename FunctionLiterals::allocator_type(factory)) {
+      funcs_(typename FunctionLiterals::allocator_type(factory)),
+      needs_arguments_(false) {
   }
   void AddUnresolved(Identifier<Factory>* name, bool is_const) {
     vars_.push_back(std::make_pair(name, is_const));
@@ -93,10 +94,19 @@ class Scope : private Noncopyable<Scope<Factory> >::type {
   this_type* GetUpperScope() {
     return up_;
   }
+  // arguments object is observable only when
+  // "arguments" or "eval" is referenced directly in this scope
+  void set_needs_arguments(bool val) {
+    needs_arguments_ = val;
+  }
+  inline bool needs_arguments() const {
+    return needs_arguments_;
+  }
  protected:
   this_type* up_;
   Variables vars_;
   FunctionLiterals funcs_;
+  bool needs_arguments_;
 };
 
 template<typename Factory>
@@ -244,6 +254,9 @@ class Block : public BlockBase<Factory> {
   inline const Statements& body() const {
     return body_;
   }
+  inline Statements& body() {
+    return body_;
+  }
   DECLARE_DERIVED_NODE_TYPE(Block)
  private:
   Statements body_;
@@ -345,6 +358,9 @@ class Declaration : public DeclarationBase<Factory> {
   inline Expression<Factory>* expr() const {
     return expr_;
   }
+  inline void set_expr(Expression<Factory>* expr) {
+    expr_ = expr;
+  }
  private:
   Identifier<Factory>* name_;
   Expression<Factory>* expr_;
@@ -382,8 +398,11 @@ class IfStatement : public IfStatementBase<Factory> {
     // else maybe NULL
   }
   inline Expression<Factory>* cond() const { return cond_; }
+  inline void set_cond(Expression<Factory>* cond) { cond_ = cond; }
   inline Statement<Factory>* then_statement() const { return then_; }
+  inline void set_then_statement(Statement<Factory>* stmt) { then_ = stmt; }
   inline Statement<Factory>* else_statement() const { return else_; }
+  inline void set_else_statement(Statement<Factory>* stmt) { else_ = stmt; }
   DECLARE_DERIVED_NODE_TYPE(IfStatement)
  private:
   Expression<Factory>* cond_;
@@ -401,7 +420,13 @@ INHERIT(IterationStatement);
 template<typename Factory>
 class IterationStatement : public IterationStatementBase<Factory> {
  public:
+  IterationStatement() : line_number_(0) { }
+  // line of the loop keyword
+  inline std::size_t line_number() const { return line_number_; }
+  inline void set_line_number(std::size_t line) { line_number_ = line; }
   DECLARE_NODE_TYPE(IterationStatement)
+ private:
+  std::size_t line_number_;
 };
 
 // DoWhileStatement
@@ -419,7 +444,9 @@ class DoWhileStatement : public DoWhileStatementBase<Factory> {
       cond_(cond) {
   }
   inline Statement<Factory>* body() const { return body_; }
+  inline void set_body(Statement<Factory>* body) { body_ = body; }
   inline Expression<Factory>* cond() const { return cond_; }
+  inline void set_cond(Expression<Factory>* cond) { cond_ = cond; }
   DECLARE_DERIVED_NODE_TYPE(DoWhileStatement)
  private:
   Statement<Factory>* body_;
@@ -441,7 +468,9 @@ class WhileStatement : public WhileStatementBase<Factory> {
       cond_(cond) {
   }
   inline Statement<Factory>* body() const { return body_; }
+  inline void set_body(Statement<Factory>* body) { body_ = body; }
   inline Expression<Factory>* cond() const { return cond_; }
+  inline void set_cond(Expression<Factory>* cond) { cond_ = cond; }
   DECLARE_DERIVED_NODE_TYPE(WhileStatement)
  private:
   Statement<Factory>* body_;
@@ -468,9 +497,13 @@ class ForStatement : public ForStatementBase<Factory> {
       next_(next) {
   }
   inline Statement<Factory>* body() const { return body_; }
+  inline void set_body(Statement<Factory>* body) { body_ = body; }
   inline Statement<Factory>* init() const { return init_; }
+  inline void set_init(Statement<Factory>* init) { init_ = init; }
   inline Expression<Factory>* cond() const { return cond_; }
+  inline void set_cond(Expression<Factory>* cond) { cond_ = cond; }
   inline Statement<Factory>* next() const { return next_; }
+  inline void set_next(Statement<Factory>* next) { next_ = next; }
   DECLARE_DERIVED_NODE_TYPE(ForStatement)
  private:
   Statement<Factory>* body_;
@@ -497,8 +530,13 @@ class ForInStatement : public ForInStatementBase<Factory> {
       enumerable_(enumerable) {
   }
   inline Statement<Factory>* body() const { return body_; }
+  inline void set_body(Statement<Factory>* body) { body_ = body; }
   inline Statement<Factory>* each() const { return each_; }
+  inline void set_each(Statement<Factory>* each) { each_ = each; }
   inline Expression<Factory>* enumerable() const { return enumerable_; }
+  inline void set_enumerable(Expression<Factory>* enumerable) {
+    enumerable_ = enumerable;
+  }
   DECLARE_DERIVED_NODE_TYPE(ForInStatement)
  private:
   Statement<Factory>* body_;
@@ -583,6 +621,7 @@ class ReturnStatement : public ReturnStatementBase<Factory> {
     : expr_(expr) {
   }
   inline Expression<Factory>* expr() const { return expr_; }
+  inline void set_expr(Expression<Factory>* expr) { expr_ = expr; }
   DECLARE_DERIVED_NODE_TYPE(ReturnStatement)
  private:
   Expression<Factory>* expr_;
@@ -604,7 +643,9 @@ class WithStatement : public WithStatementBase<Factory> {
       body_(body) {
   }
   inline Expression<Factory>* context() const { return context_; }
+  inline void set_context(Expression<Factory>* context) { context_ = context; }
   inline Statement<Factory>* body() const { return body_; }
+  inline void set_body(Statement<Factory>* body) { body_ = body; }
   DECLARE_DERIVED_NODE_TYPE(WithStatement)
  private:
   Expression<Factory>* context_;
@@ -627,6 +668,7 @@ class LabelledStatement : public LabelledStatementBase<Factory> {
   }
   inline Identifier<Factory>* label() const { return label_; }
   inline Statement<Factory>* body() const { return body_; }
+  inline void set_body(Statement<Factory>* body) { body_ = body; }
   DECLARE_DERIVED_NODE_TYPE(LabelledStatement)
  private:
   Identifier<Factory>* label_;
@@ -660,9 +702,15 @@ class CaseClause : public CaseClauseBase<Factory> {
   inline Expression<Factory>* expr() const {
     return expr_;
   }
+  inline void set_expr(Expression<Factory>* expr) {
+    expr_ = expr;
+  }
   inline const Statements& body() const {
     return body_;
   }
+  inline Statements& body() {
+    return body_;
+  }
  private:
   Expression<Factory>* expr_;
   Statements body_;
@@ -690,6 +738,7 @@ class SwitchStatement : public SwitchStatementBase<Factory> {
     clauses_.push_back(clause);
   }
   inline Expression<Factory>* expr() const { return expr_; }
+  inline void set_expr(Expression<Factory>* expr) { expr_ = expr; }
   inline const CaseClauses& clauses() const { return clauses_; }
   DECLARE_DERIVED_NODE_TYPE(SwitchStatement)
  private:
@@ -711,6 +760,7 @@ class ThrowStatement : public ThrowStatementBase<Factory> {
     : expr_(expr) {
   }
   inline Expression<Factory>* expr() const { return expr_; }
+  inline void set_expr(Expression<Factory>* expr) { expr_ = expr; }
   DECLARE_DERIVED_NODE_TYPE(ThrowStatement)
  private:
   Expression<Factory>* expr_;
@@ -771,6 +821,7 @@ class ExpressionStatement : public ExpressionStatementBase<Factory> {
  public:
   explicit ExpressionStatement(Expression<Factory>* expr) : expr_(expr) { }
   inline Expression<Factory>* expr() const { return expr_; }
+  inline void set_expr(Expression<Factory>* expr) { expr_ = expr; }
   DECLARE_DERIVED_NODE_TYPE(ExpressionStatement)
  private:
   Expression<Factory>* expr_;
@@ -794,7 +845,9 @@ class Assignment : public AssignmentBase<Factory> {
   }
   inline Token::Type op() const { return op_; }
   inline Expression<Factory>* left() const { return left_; }
+  inline void set_left(Expression<Factory>* left) { left_ = left; }
   inline Expression<Factory>* right() const { return right_; }
+  inline void set_right(Expression<Factory>* right) { right_ = right; }
   DECLARE_DERIVED_NODE_TYPE(Assignment)
  private:
   Token::Type op_;
@@ -820,7 +873,9 @@ class BinaryOperation : public BinaryOperationBase<Factory> {
   }
   inline Token::Type op() const { return op_; }
   inline Expression<Factory>* left() const { return left_; }
+  inline void set_left(Expression<Factory>* left) { left_ = left; }
   inline Expression<Factory>* right() const { return right_; }
+  inline void set_right(Expression<Factory>* right) { right_ = right; }
   DECLARE_DERIVED_NODE_TYPE(BinaryOperation)
  private:
   Token::Type op_;
@@ -844,8 +899,11 @@ class ConditionalExpression : public ConditionalExpressionBase<Factory> {
     : cond_(cond), left_(left), right_(right) {
   }
   inline Expression<Factory>* cond() const { return cond_; }
+  inline void set_cond(Expression<Factory>* cond) { cond_ = cond; }
   inline Expression<Factory>* left() const { return left_; }
+  inline void set_left(Expression<Factory>* left) { left_ = left; }
   inline Expression<Factory>* right() const { return right_; }
+  inline void set_right(Expression<Factory>* right) { right_ = right; }
   DECLARE_DERIVED_NODE_TYPE(ConditionalExpression)
  private:
   Expression<Factory>* cond_;
@@ -869,6 +927,7 @@ class UnaryOperation : public UnaryOperationBase<Factory> {
   }
   inline Token::Type op() const { return op_; }
   inline Expression<Factory>* expr() const { return expr_; }
+  inline void set_expr(Expression<Factory>* expr) { expr_ = expr; }
   DECLARE_DERIVED_NODE_TYPE(UnaryOperation)
  private:
   Token::Type op_;
@@ -891,6 +950,7 @@ class PostfixExpression : public PostfixExpressionBase<Factory> {
   }
   inline Token::Type op() const { return op_; }
   inline Expression<Factory>* expr() const { return expr_; }
+  inline void set_expr(Expression<Factory>* expr) { expr_ = expr; }
   DECLARE_DERIVED_NODE_TYPE(PostfixExpression)
  private:
   Token::Type op_;
@@ -907,7 +967,7 @@ INHERIT(StringLiteral);
 template<typename Factory>
 class StringLiteral : public StringLiteralBase<Factory> {
  public:
-  typedef typename SpaceUString<Factory>::type value_type;
+  typedef UStringPiece value_type;
   StringLiteral(const std::vector<uc16>& buffer,
                 Factory* factory)
   {
@@ -922,10 +982,7 @@ class StringLiteral : public StringLiteralBase<Factory> {
   StringLiteral() { }
   void InitializeStringLiteral(const std::vector<uc16>& buffer,
                                Factory* factory) {
-    value_ = value_type(
-        buffer.data(),
-        buffer.size(),
-        typename value_type::allocator_type(factory));
+    value_ = NewSpaceUStringPiece(factory, buffer.begin(), buffer.end());
   }
  private:
   value_type value_;
@@ -977,12 +1034,10 @@ INHERIT(Identifier);
 template<typename Factory>
 class Identifier : public IdentifierBase<Factory> {
  public:
-  typedef typename SpaceUString<Factory>::type value_type;
+  typedef UStringPiece value_type;
   template<typename Range>
   Identifier(const Range& range, Factory* factory)
-    : value_(range.begin(),
-             range.end(),
-             typename value_type::allocator_type(factory)) {
+    : value_(NewSpaceUStringPiece(factory, range.begin(), range.end())) {
   }
   inline const value_type& value() const {
     return value_;
@@ -1103,15 +1158,13 @@ INHERIT(RegExpLiteral);
 template<typename Factory>
 class RegExpLiteral : public RegExpLiteralBase<Factory> {
  public:
-  typedef typename SpaceUString<Factory>::type value_type;
+  typedef UStringPiece value_type;
 
   RegExpLiteral(const std::vector<uc16>& buffer,
                 const std::vector<uc16>& flags,
                 Factory* factory)
-    : value_(buffer.data(),
-             buffer.size(), typename value_type::allocator_type(factory)),
-      flags_(flags.data(),
-             flags.size(), typename value_type::allocator_type(factory)) {
+    : value_(NewSpaceUStringPiece(factory, buffer.begin(), buffer.end())),
+      flags_(NewSpaceUStringPiece(factory, flags.begin(), flags.end())) {
   }
   inline const value_type& value() const { return value_; }
   inline const value_type& flags() const { return flags_; }
@@ -1142,6 +1195,9 @@ class ArrayLiteral : public ArrayLiteralBase<Factory> {
   inline const Expressions& items() const {
     return items_;
   }
+  inline Expressions& items() {
+    return items_;
+  }
   DECLARE_DERIVED_NODE_TYPE(ArrayLiteral)
  private:
   Expressions items_;
@@ -1182,6 +1238,9 @@ class ObjectLiteral : public ObjectLiteralBase<Factory> {
   inline const Properties& properties() const {
     return properties_;
   }
+  inline Properties& properties() {
+    return properties_;
+  }
   DECLARE_DERIVED_NODE_TYPE(ObjectLiteral)
  private:
   inline void AddPropertyDescriptor(PropertyDescriptorType type,
@@ -1226,6 +1285,9 @@ class FunctionLiteral : public FunctionLiteralBase<Factory> {
   inline const Statements& body() const {
     return body_;
   }
+  inline Statements& body() {
+    return body_;
+  }
   inline Scope<Factory>* scope() {
     return &scope_;
   }
@@ -1290,6 +1352,7 @@ class PropertyAccess : public PropertyAccessBase<Factory> {
  public:
   inline bool IsValidLeftHandSide() const { return true; }
   inline Expression<Factory>* target() const { return target_; }
+  inline void set_target(Expression<Factory>* target) { target_ = target; }
   DECLARE_NODE_TYPE(PropertyAccess)
  protected:
   void InitializePropertyAccess(Expression<Factory>* obj) {
@@ -1335,6 +1398,7 @@ class IndexAccess : public IndexAccessBase<Factory> {
     InitializePropertyAccess(obj);
   }
   inline Expression<Factory>* key() const { return key_; }
+  inline void set_key(Expression<Factory>* key) { key_ = key; }
   DECLARE_DERIVED_NODE_TYPE(IndexAccess)
  private:
   Expression<Factory>* key_;
@@ -1372,7 +1436,9 @@ class FunctionCall : public FunctionCallBase<Factory> {
   }
   void AddArgument(Expression<Factory>* expr) { args_.push_back(expr); }
   inline Expression<Factory>* target() const { return target_; }
+  inline void set_target(Expression<Factory>* target) { target_ = target; }
   inline const Expressions& args() const { return args_; }
+  inline Expressions& args() { return args_; }
   DECLARE_DERIVED_NODE_TYPE(FunctionCall)
  private:
   Expression<Factory>* target_;
@@ -1397,7 +1463,9 @@ class ConstructorCall : public ConstructorCallBase<Factory> {
   }
   void AddArgument(Expression<Factory>* expr) { args_.push_back(expr); }
   inline Expression<Factory>* target() const { return target_; }
+  inline void set_target(Expression<Factory>* target) { target_ = target; }
   inline const Expressions& args() const { return args_; }
+  inline Expressions& args() { return args_; }
   DECLARE_DERIVED_NODE_TYPE(ConstructorCall)
  private:
   Expression<Factory>* target_;
@@ -1414,8 +1482,7 @@ template<class Factory>
 struct hash<iv::core::ast::IdentifierKey<Factory> >
   : public unary_function<iv::core::ast::IdentifierKey<Factory>, std::size_t> {
   std::size_t operator()(const iv::core::ast::IdentifierKey<Factory>& x) const {
-    return hash<
-        typename iv::core::ast::Identifier<Factory>::value_type>()(x.value());
+    return iv::core::StringToHash(x.value());
   }
 };
 } }  // namespace std::tr1
@@ -27,25 +27,12 @@ class BasicAstFactory {
   AST_STRING(V)
 #undef V
 
-  BasicAstFactory()
-    : undefined_instance_(
-          new(static_cast<Factory*>(this))Undefined()),
-      empty_statement_instance_(
-          new(static_cast<Factory*>(this))EmptyStatement()),
-      debugger_statement_instance_(
-          new(static_cast<Factory*>(this))DebuggerStatement()),
-      this_instance_(
-          new(static_cast<Factory*>(this))ThisLiteral()),
-      null_instance_(
-          new(static_cast<Factory*>(this))NullLiteral()),
-      true_instance_(
-          new(static_cast<Factory*>(this))TrueLiteral()),
-      false_instance_(
-          new(static_cast<Factory*>(this))FalseLiteral()) {
+  BasicAstFactory() {
     typedef std::tr1::is_convertible<Factory, this_type> is_convertible_to_this;
     typedef std::tr1::is_base_of<this_type, Factory> is_base_of_factory;
     IV_STATIC_ASSERT(is_convertible_to_this::value ||
                      is_base_of_factory::value);
+    CreateInstances();
   }
 
   template<typename Range>
@@ -284,6 +271,20 @@ class BasicAstFactory {
     return new (static_cast<Factory*>(this)) IdentifierAccess(expr, ident);
   }
 
+ protected:
+  // singleton nodes are allocated in factory space,
+  // so Factory must create them again after clearing space
+  void CreateInstances() {
+    Factory* const factory = static_cast<Factory*>(this);
+    undefined_instance_ = new(factory)Undefined();
+    empty_statement_instance_ = new(factory)EmptyStatement();
+    debugger_statement_instance_ = new(factory)DebuggerStatement();
+    this_instance_ = new(factory)ThisLiteral();
+    null_instance_ = new(factory)NullLiteral();
+    true_instance_ = new(factory)TrueLiteral();
+    false_instance_ = new(factory)FalseLiteral();
+  }
+
  private:
   Undefined* undefined_instance_;
   EmptyStatement* empty_statement_instance_;
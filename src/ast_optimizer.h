@@ -0,0 +1,493 @@
+#ifndef _IV_AST_OPTIMIZER_H_
+#define _IV_AST_OPTIMIZER_H_
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "uchar.h"
+#include "token.h"
+#include "ast.h"
+#include "ast_visitor.h"
+#include "conversions.h"
+#include "dtoa.h"
+#include "noncopyable.h"
+#include "ustringpiece.h"
+namespace iv {
+namespace core {
+namespace ast {
+
+// AstOptimizer
+// folds constant expressions and removes unreachable statements in place.
+// use between Parser::ParseProgram and execution:
+//
+//   AstOptimizer<Factory> optimizer(&factory);
+//   optimizer.Optimize(global);
+//
+// declarations are already registered in each FunctionLiteral scope by
+// the parser, so pruning statements never changes variable hoisting.
+template<typename Factory>
+class AstOptimizer : public AstVisitor<Factory>::type {
+ public:
+  typedef void ReturnType;
+
+#define V(AST) typedef typename iv::core::ast::AST<Factory> AST;
+  AST_NODE_LIST(V)
+#undef V
+#define V(X, XS) typedef typename core::SpaceVector<Factory, X *>::type XS;
+  AST_LIST_LIST(V)
+#undef V
+  typedef typename ObjectLiteral::Properties Properties;
+
+  explicit AstOptimizer(Factory* factory)
+    : factory_(factory),
+      expr_(NULL),
+      stmt_(NULL) {
+  }
+
+  void Optimize(FunctionLiteral* global) {
+    OptimizeStatements(&global->body());
+  }
+
+  void Visit(Block* block) {
+    OptimizeStatements(&block->body());
+  }
+
+  void Visit(FunctionStatement* func) {
+    Visit(func->function());
+  }
+
+  void Visit(FunctionDeclaration* func) {
+    Visit(func->function());
+  }
+
+  void Visit(VariableStatement* var) {
+    for (typename Declarations::const_iterator it = var->decls().begin(),
+         last = var->decls().end(); it != last; ++it) {
+      if ((*it)->expr()) {
+        (*it)->set_expr(Optimize((*it)->expr()));
+      }
+    }
+  }
+
+  void Visit(EmptyStatement* empty) { }
+
+  // section 12.5 The if Statement
+  void Visit(IfStatement* ifstmt) {
+    ifstmt->set_cond(Optimize(ifstmt->cond()));
+    ifstmt->set_then_statement(Optimize(ifstmt->then_statement()));
+    if (ifstmt->else_statement()) {
+      ifstmt->set_else_statement(Optimize(ifstmt->else_statement()));
+    }
+    bool cond;
+    if (ToBoolean(ifstmt->cond(), &cond)) {
+      if (cond) {
+        stmt_ = ifstmt->then_statement();
+      } else if (ifstmt->else_statement()) {
+        stmt_ = ifstmt->else_statement();
+      } else {
+        stmt_ = factory_->NewEmptyStatement();
+      }
+    }
+  }
+
+  void Visit(DoWhileStatement* dowhile) {
+    dowhile->set_body(Optimize(dowhile->body()));
+    dowhile->set_cond(Optimize(dowhile->cond()));
+  }
+
+  // section 12.6.2 The while Statement
+  void Visit(WhileStatement* whilestmt) {
+    whilestmt->set_cond(Optimize(whilestmt->cond()));
+    whilestmt->set_body(Optimize(whilestmt->body()));
+    bool cond;
+    if (ToBoolean(whilestmt->cond(), &cond) && !cond) {
+      stmt_ = factory_->NewEmptyStatement();
+    }
+  }
+
+  void Visit(ForStatement* forstmt) {
+    if (forstmt->init()) {
+      forstmt->set_init(Optimize(forstmt->init()));
+    }
+    if (forstmt->cond()) {
+      forstmt->set_cond(Optimize(forstmt->cond()));
+    }
+    if (forstmt->next()) {
+      forstmt->set_next(Optimize(forstmt->next()));
+    }
+    forstmt->set_body(Optimize(forstmt->body()));
+  }
+
+  void Visit(ForInStatement* forstmt) {
+    OptimizeReference(forstmt->each());
+    forstmt->set_enumerable(Optimize(forstmt->enumerable()));
+    forstmt->set_body(Optimize(forstmt->body()));
+  }
+
+  void Visit(ContinueStatement* continuestmt) { }
+
+  void Visit(BreakStatement* breakstmt) { }
+
+  void Visit(ReturnStatement* returnstmt) {
+    returnstmt->set_expr(Optimize(returnstmt->expr()));
+  }
+
+  void Visit(WithStatement* withstmt) {
+    withstmt->set_context(Optimize(withstmt->context()));
+    withstmt->set_body(Optimize(withstmt->body()));
+  }
+
+  void Visit(LabelledStatement* labelledstmt) {
+    labelledstmt->set_body(Optimize(labelledstmt->body()));
+  }
+
+  void Visit(SwitchStatement* switchstmt) {
+    switchstmt->set_expr(Optimize(switchstmt->expr()));
+    for (typename CaseClauses::const_iterator
+         it = switchstmt->clauses().begin(),
+         last = switchstmt->clauses().end(); it != last; ++it) {
+      if (!(*it)->IsDefault()) {
+        (*it)->set_expr(Optimize((*it)->expr()));
+      }
+      OptimizeStatements(&(*it)->body());
+    }
+  }
+
+  void Visit(ThrowStatement* throwstmt) {
+    throwstmt->set_expr(Optimize(throwstmt->expr()));
+  }
+
+  void Visit(TryStatement* trystmt) {
+    Visit(trystmt->body());
+    if (trystmt->catch_block()) {
+      Visit(trystmt->catch_block());
+    }
+    if (trystmt->finally_block()) {
+      Visit(trystmt->finally_block());
+    }
+  }
+
+  void Visit(DebuggerStatement* debuggerstmt) { }
+
+  void Visit(ExpressionStatement* exprstmt) {
+    exprstmt->set_expr(Optimize(exprstmt->expr()));
+  }
+
+  void Visit(Assignment* assign) {
+    OptimizeReference(assign->left());
+    assign->set_right(Optimize(assign->right()));
+  }
+
+  void Visit(BinaryOperation* binary) {
+    binary->set_left(Optimize(binary->left()));
+    binary->set_right(Optimize(binary->right()));
+    const Token::Type op = binary->op();
+    Expression* const left = binary->left();
+    Expression* const right = binary->right();
+    bool cond;
+    if (op == Token::LOGICAL_AND || op == Token::LOGICAL_OR) {
+      // section 11.11 Binary Logical Operators
+      if (ToBoolean(left, &cond)) {
+        expr_ = ((op == Token::LOGICAL_AND) == cond) ? right : left;
+      }
+    } else if (left->AsNumberLiteral() && right->AsNumberLiteral()) {
+      expr_ = ReduceNumbers(op,
+                            left->AsNumberLiteral()->value(),
+                            right->AsNumberLiteral()->value());
+    } else if (left->AsStringLiteral() && right->AsStringLiteral()) {
+      expr_ = ReduceStrings(op,
+                            left->AsStringLiteral()->value(),
+                            right->AsStringLiteral()->value());
+    } else if (op == Token::ADD) {
+      // section 11.6.1 The Addition operator ( + )
+      // string concatenation with number literal
+      if (left->AsStringLiteral() && right->AsNumberLiteral()) {
+        expr_ = Concat(left->AsStringLiteral()->value(),
+                       NumberToString(right->AsNumberLiteral()->value()));
+      } else if (left->AsNumberLiteral() && right->AsStringLiteral()) {
+        expr_ = Concat(NumberToString(left->AsNumberLiteral()->value()),
+                       right->AsStringLiteral()->value());
+      }
+    }
+  }
+
+  // section 11.12 Conditional Operator ( ? : )
+  void Visit(ConditionalExpression* cond) {
+    cond->set_cond(Optimize(cond->cond()));
+    cond->set_left(Optimize(cond->left()));
+    cond->set_right(Optimize(cond->right()));
+    bool res;
+    if (ToBoolean(cond->cond(), &res)) {
+      expr_ = res ? cond->left() : cond->right();
+    }
+  }
+
+  void Visit(UnaryOperation* unary) {
+    const Token::Type op = unary->op();
+    if (op == Token::DELETE || op == Token::TYPEOF ||
+        op == Token::INC || op == Token::DEC) {
+      // operand is evaluated as Reference
+      OptimizeReference(unary->expr());
+    } else {
+      unary->set_expr(Optimize(unary->expr()));
+    }
+    Expression* const expr = unary->expr();
+    bool cond;
+    if (op == Token::NOT) {
+      // section 11.4.9 Logical NOT Operator ( ! )
+      if (ToBoolean(expr, &cond)) {
+        expr_ = NewBoolean(!cond);
+      }
+    } else if (op == Token::TYPEOF) {
+      // section 11.4.3 The typeof Operator
+      const char* type = NULL;
+      if (expr->AsNumberLiteral()) {
+        type = "number";
+      } else if (expr->AsStringLiteral()) {
+        type = "string";
+      } else if (expr->AsTrueLiteral() || expr->AsFalseLiteral()) {
+        type = "boolean";
+      } else if (expr->AsNullLiteral()) {
+        type = "object";
+      } else if (expr->AsUndefined()) {
+        type = "undefined";
+      }
+      if (type) {
+        expr_ = NewString(StringPiece(type));
+      }
+    }
+  }
+
+  void Visit(PostfixExpression* postfix) {
+    OptimizeReference(postfix->expr());
+  }
+
+  void Visit(StringLiteral* literal) { }
+
+  void Visit(NumberLiteral* literal) { }
+
+  void Visit(Identifier* literal) { }
+
+  void Visit(ThisLiteral* literal) { }
+
+  void Visit(NullLiteral* literal) { }
+
+  void Visit(TrueLiteral* literal) { }
+
+  void Visit(FalseLiteral* literal) { }
+
+  void Visit(Undefined* literal) { }
+
+  void Visit(RegExpLiteral* literal) { }
+
+  void Visit(ArrayLiteral* literal) {
+    for (typename Expressions::iterator it = literal->items().begin(),
+         last = literal->items().end(); it != last; ++it) {
+      if (*it) {
+        *it = Optimize(*it);
+      }
+    }
+  }
+
+  void Visit(ObjectLiteral* literal) {
+    using std::tr1::get;
+    for (typename Properties::iterator it = literal->properties().begin(),
+         last = literal->properties().end(); it != last; ++it) {
+      get<2>(*it) = Optimize(get<2>(*it));
+    }
+  }
+
+  void Visit(FunctionLiteral* literal) {
+    OptimizeStatements(&literal->body());
+  }
+
+  void Visit(IndexAccess* prop) {
+    prop->set_target(Optimize(prop->target()));
+    prop->set_key(Optimize(prop->key()));
+  }
+
+  void Visit(IdentifierAccess* prop) {
+    prop->set_target(Optimize(prop->target()));
+  }
+
+  void Visit(FunctionCall* call) {
+    // target is evaluated as Reference (this binding and direct eval)
+    OptimizeReference(call->target());
+    OptimizeArguments(&call->args());
+  }
+
+  void Visit(ConstructorCall* call) {
+    call->set_target(Optimize(call->target()));
+    OptimizeArguments(&call->args());
+  }
+
+ private:
+  Expression* Optimize(Expression* expr) {
+    expr->Accept(this);
+    Expression* const res = expr_ ? expr_ : expr;
+    expr_ = NULL;
+    return res;
+  }
+
+  Statement* Optimize(Statement* stmt) {
+    stmt->Accept(this);
+    Statement* const res = stmt_ ? stmt_ : stmt;
+    stmt_ = NULL;
+    return res;
+  }
+
+  // optimize children only, expression itself must be kept
+  // because replacing it changes Reference semantics
+  void OptimizeReference(Expression* expr) {
+    expr->Accept(this);
+    expr_ = NULL;
+  }
+
+  void OptimizeReference(Statement* stmt) {
+    stmt->Accept(this);
+    stmt_ = NULL;
+  }
+
+  void OptimizeArguments(Expressions* args) {
+    for (typename Expressions::iterator it = args->begin(),
+         last = args->end(); it != last; ++it) {
+      *it = Optimize(*it);
+    }
+  }
+
+  // optimize each statement and drop statements after
+  // unconditional return, throw, break and continue
+  void OptimizeStatements(Statements* body) {
+    for (typename Statements::iterator it = body->begin(),
+         last = body->end(); it != last; ++it) {
+      *it = Optimize(*it);
+      if ((*it)->AsReturnStatement() ||
+          (*it)->AsThrowStatement() ||
+          (*it)->AsBreakStatement() ||
+          (*it)->AsContinueStatement()) {
+        body->erase(it + 1, last);
+        break;
+      }
+    }
+  }
+
+  // section 9.2 ToBoolean
+  // returns false when expr is not constant
+  static bool ToBoolean(const Expression* expr, bool* res) {
+    if (expr->AsTrueLiteral()) {
+      *res = true;
+    } else if (expr->AsFalseLiteral() ||
+               expr->AsNullLiteral() ||
+               expr->AsUndefined()) {
+      *res = false;
+    } else if (expr->AsNumberLiteral()) {
+      const double val = expr->AsNumberLiteral()->value();
+      *res = !(val == 0 || std::isnan(val));
+    } else if (expr->AsStringLiteral()) {
+      *res = !expr->AsStringLiteral()->value().empty();
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  Expression* ReduceNumbers(Token::Type op, double l_val, double r_val) {
+    switch (op) {
+      case Token::ADD:
+        return factory_->NewNumberLiteral(l_val + r_val);
+      case Token::SUB:
+        return factory_->NewNumberLiteral(l_val - r_val);
+      case Token::MUL:
+        return factory_->NewNumberLiteral(l_val * r_val);
+      case Token::DIV:
+        return factory_->NewNumberLiteral(l_val / r_val);
+      case Token::MOD:
+        return factory_->NewNumberLiteral(std::fmod(l_val, r_val));
+      case Token::LT:
+        return NewBoolean(l_val < r_val);
+      case Token::GT:
+        return NewBoolean(l_val > r_val);
+      case Token::LTE:
+        return NewBoolean(l_val <= r_val);
+      case Token::GTE:
+        return NewBoolean(l_val >= r_val);
+      case Token::EQ:
+      case Token::EQ_STRICT:
+        return NewBoolean(l_val == r_val);
+      case Token::NE:
+      case Token::NE_STRICT:
+        return NewBoolean(l_val != r_val);
+      default:
+        return NULL;
+    }
+  }
+
+  // compare by code units (section 11.8.5 step 4)
+  Expression* ReduceStrings(Token::Type op,
+                            const UStringPiece& lhs,
+                            const UStringPiece& rhs) {
+    switch (op) {
+      case Token::ADD:
+        return Concat(lhs, rhs);
+      case Token::LT:
+        return NewBoolean(Less(lhs, rhs));
+      case Token::GT:
+        return NewBoolean(Less(rhs, lhs));
+      case Token::LTE:
+        return NewBoolean(!Less(rhs, lhs));
+      case Token::GTE:
+        return NewBoolean(!Less(lhs, rhs));
+      case Token::EQ:
+      case Token::EQ_STRICT:
+        return NewBoolean(Equals(lhs, rhs));
+      case Token::NE:
+      case Token::NE_STRICT:
+        return NewBoolean(!Equals(lhs, rhs));
+      default:
+        return NULL;
+    }
+  }
+
+  static bool Less(const UStringPiece& lhs, const UStringPiece& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(),
+                                        rhs.begin(), rhs.end());
+  }
+
+  static bool Equals(const UStringPiece& lhs, const UStringPiece& rhs) {
+    return lhs.size() == rhs.size() &&
+        std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  // section 9.8.1 ToString Applied to the Number Type
+  std::vector<uc16> NumberToString(double val) {
+    char buffer[80];
+    const StringPiece str(DoubleToCString(val, buffer, 80));
+    return std::vector<uc16>(str.begin(), str.end());
+  }
+
+  template<typename LHS, typename RHS>
+  Expression* Concat(const LHS& lhs, const RHS& rhs) {
+    std::vector<uc16> buffer(lhs.begin(), lhs.end());
+    buffer.insert(buffer.end(), rhs.begin(), rhs.end());
+    return factory_->NewStringLiteral(buffer);
+  }
+
+  Expression* NewString(const StringPiece& str) {
+    return factory_->NewStringLiteral(
+        std::vector<uc16>(str.begin(), str.end()));
+  }
+
+  Expression* NewBoolean(bool val) {
+    if (val) {
+      return factory_->NewTrueLiteral();
+    } else {
+      return factory_->NewFalseLiteral();
+    }
+  }
+
+  Factory* factory_;
+  Expression* expr_;
+  Statement* stmt_;
+};
+
+} } }  // namespace iv::core::ast
+#endif  // _IV_AST_OPTIMIZER_H_
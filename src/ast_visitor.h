@@ -21,8 +21,7 @@ struct AstVisitorTraits<true, T> {
 
 template<typename T>
 struct AstVisitorTraits<false, T> {
-  typedef typename std::tr1::add_pointer<
-      typename std::tr1::add_const<T>::type>::type type;
+  typedef typename std::tr1::add_pointer<T>::type type;
 };
 
 }  // namespace iv::core::ast::detail
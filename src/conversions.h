@@ -421,32 +421,34 @@ inline double DoubleToInteger(double d) {
   return std::floor(std::abs(d)) * (std::signbit(d) ? -1 : 1);
 }
 
+// section 15.4 array index
+// str is canonical decimal form of uint32 value less than 2^32 - 1,
+// so "0" is index and "01", "+1", "" are not
 inline bool ConvertToUInt32(const UStringPiece& str, uint32_t* value) {
   static const uint32_t uint32_t_max = std::numeric_limits<uint32_t>::max();
-  uint16_t ch;
   *value = 0;
   UStringPiece::const_iterator it = str.begin();
   const UStringPiece::const_iterator last = str.end();
-  if (it != last && *it != '0' && Chars::IsDecimalDigit(*it)) {
-    ch = *it - '0';
-    *value = ch;
-  } else {
+  if (it == last || !Chars::IsDecimalDigit(*it)) {
     return false;
   }
-  ++it;
-  uint32_t prev = *value;
-  for (;it != last; ++it) {
-    prev = *value;
-    if (Chars::IsDecimalDigit(*it)) {
-      ch = *it - '0';
-      *value = ch + (prev * 10);
-    } else {
+  if (*it == '0') {
+    return str.size() == 1;
+  }
+  uint32_t res = 0;
+  for (; it != last; ++it) {
+    if (!Chars::IsDecimalDigit(*it)) {
+      return false;
+    }
+    const uint32_t ch = *it - '0';
+    // res * 10 + ch must be less than uint32_t_max
+    if (res > (uint32_t_max - 1 - ch) / 10) {
       return false;
     }
+    res = res * 10 + ch;
   }
-  return (prev < (uint32_t_max / 10) ||
-          ((prev == (uint32_t_max / 10)) &&
-           (ch < (uint32_t_max % 10))));
+  *value = res;
+  return true;
 }
 
 template<typename T>
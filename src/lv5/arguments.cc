@@ -0,0 +1,30 @@
+#include <algorithm>
+#include <gc/gc.h>
+#include "arguments.h"
+#include "context.h"
+#include "stack.h"
+namespace iv {
+namespace lv5 {
+
+Arguments::Arguments(Context* ctx, std::size_t n)
+  : ctx_(ctx),
+    this_binding_(),
+    stack_(ctx->stack()),
+    args_(stack_->Gain(n)),
+    size_(n),
+    constructor_call_(false) {
+  if (!args_) {
+    // VM stack is exhausted, so fall back to GC heap
+    stack_ = NULL;
+    args_ = static_cast<JSVal*>(GC_MALLOC(n * sizeof(JSVal)));
+  }
+  std::fill(args_, args_ + n, JSUndefined);
+}
+
+Arguments::~Arguments() {
+  if (stack_) {
+    stack_->Release(size_);
+  }
+}
+
+} }  // namespace iv::lv5
@@ -1,6 +1,5 @@
 #ifndef IV_LV5_ARGUMENTS_H_
 #define IV_LV5_ARGUMENTS_H_
-#include <vector>
 #include <iterator>
 #include <algorithm>
 #include "jsval.h"
@@ -10,75 +9,67 @@ namespace iv {
 namespace lv5 {
 class Interpreter;
 class Context;
+class Stack;
 
+// Arguments
+// argument values are placed on the VM stack segment of Context,
+// so Arguments must be destroyed in LIFO order (automatic variable only).
 class Arguments : private core::Noncopyable<Arguments>::type {
  public:
-  typedef std::vector<JSVal> JSVals;
   typedef Arguments this_type;
 
-  typedef JSVals::value_type value_type;
-  typedef JSVals::reference reference;
-  typedef JSVals::const_reference const_reference;
-  typedef JSVals::iterator iterator;
-  typedef JSVals::const_iterator const_iterator;
-  typedef JSVals::pointer pointer;
-  typedef JSVals::difference_type difference_type;
-  typedef JSVals::size_type size_type;
-
-  typedef JSVals::const_reverse_iterator const_reverse_iterator;
-  typedef JSVals::reverse_iterator reverse_iterator;
-
-  inline iterator begin() { return args_.begin(); }
-  inline const_iterator begin() const { return args_.begin(); }
-  inline iterator end() { return args_.end(); }
-  inline const_iterator end() const { return args_.end(); }
-  inline reverse_iterator rbegin() { return args_.rbegin(); }
-  inline const_reverse_iterator rbegin() const { return args_.rbegin(); }
-  inline reverse_iterator rend() { return args_.rend(); }
-  inline const_reverse_iterator rend() const { return args_.rend(); }
-
-  size_type max_size() const { return args_.max_size(); }
-  size_type capacity() const { return args_.capacity(); }
-  size_type size() const { return args_.size(); }
-  bool empty() const { return args_.empty(); }
-  void swap(JSVals& rhs) { args_.swap(rhs); }
-  void swap(this_type& rhs) {
-    using std::swap;
-    args_.swap(rhs.args_);
-    swap(ctx_, rhs.ctx_);
-    swap(this_binding_, rhs.this_binding_);
+  typedef JSVal value_type;
+  typedef JSVal& reference;
+  typedef const JSVal& const_reference;
+  typedef JSVal* iterator;
+  typedef const JSVal* const_iterator;
+  typedef JSVal* pointer;
+  typedef std::ptrdiff_t difference_type;
+  typedef std::size_t size_type;
+
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+
+  inline iterator begin() { return args_; }
+  inline const_iterator begin() const { return args_; }
+  inline iterator end() { return args_ + size_; }
+  inline const_iterator end() const { return args_ + size_; }
+  inline reverse_iterator rbegin() { return reverse_iterator(end()); }
+  inline const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
   }
+  inline reverse_iterator rend() { return reverse_iterator(begin()); }
+  inline const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
   reference operator[](size_type n) { return args_[n]; }
   const_reference operator[](size_type n) const { return args_[n]; }
 
   explicit Arguments(Context* ctx)
     : ctx_(ctx),
       this_binding_(),
-      args_(),
+      stack_(NULL),
+      args_(NULL),
+      size_(0),
       constructor_call_(false) {
   }
 
   Arguments(Context* ctx, const JSVal& this_binding)
     : ctx_(ctx),
       this_binding_(this_binding),
-      args_(),
+      stack_(NULL),
+      args_(NULL),
+      size_(0),
       constructor_call_(false) {
   }
 
-  Arguments(Context* ctx, std::size_t n)
-    : ctx_(ctx),
-      this_binding_(),
-      args_(n),
-      constructor_call_(false) {
-  }
-
-  inline const JSVals& args() const {
-    return args_;
-  }
+  // n values initialized by undefined are gained from VM stack
+  Arguments(Context* ctx, std::size_t n);
 
-  inline void push_back(const JSVal& val) {
-    args_.push_back(val);
-  }
+  ~Arguments();
 
   Context* ctx() const {
     return ctx_;
@@ -103,7 +94,9 @@ class Arguments : private core::Noncopyable<Arguments>::type {
  private:
   Context* ctx_;
   JSVal this_binding_;
-  std::vector<JSVal> args_;
+  Stack* stack_;
+  JSVal* args_;
+  std::size_t size_;
   bool constructor_call_;
 };
 
@@ -0,0 +1,200 @@
+#ifndef _IV_LV5_AST_WALKER_H_
+#define _IV_LV5_AST_WALKER_H_
+#include <tr1/tuple>
+#include <boost/foreach.hpp>
+#include "jsast.h"
+namespace iv {
+namespace lv5 {
+
+// visits every node of AST including inner functions.
+// analyses override the nodes they are interested in.
+class AstWalker : public AstVisitor {
+ protected:
+  void Accept(const AstNode* node) {
+    if (node) {
+      node->Accept(this);
+    }
+  }
+
+  template<typename Nodes>
+  void AcceptAll(const Nodes& nodes) {
+    for (typename Nodes::const_iterator it = nodes.begin(),
+         last = nodes.end(); it != last; ++it) {
+      Accept(*it);
+    }
+  }
+
+  void Visit(const Block* block) {
+    AcceptAll(block->body());
+  }
+
+  void Visit(const FunctionStatement* func) {
+    Accept(func->function());
+  }
+
+  void Visit(const FunctionDeclaration* func) {
+    Accept(func->function());
+  }
+
+  void Visit(const VariableStatement* var) {
+    BOOST_FOREACH(const Declaration* const decl, var->decls()) {
+      Accept(decl->name());
+      Accept(decl->expr());
+    }
+  }
+
+  void Visit(const EmptyStatement* empty) { }
+
+  void Visit(const IfStatement* stmt) {
+    Accept(stmt->cond());
+    Accept(stmt->then_statement());
+    Accept(stmt->else_statement());
+  }
+
+  void Visit(const DoWhileStatement* stmt) {
+    Accept(stmt->body());
+    Accept(stmt->cond());
+  }
+
+  void Visit(const WhileStatement* stmt) {
+    Accept(stmt->cond());
+    Accept(stmt->body());
+  }
+
+  void Visit(const ForStatement* stmt) {
+    Accept(stmt->init());
+    Accept(stmt->cond());
+    Accept(stmt->next());
+    Accept(stmt->body());
+  }
+
+  void Visit(const ForInStatement* stmt) {
+    Accept(stmt->each());
+    Accept(stmt->enumerable());
+    Accept(stmt->body());
+  }
+
+  void Visit(const ContinueStatement* stmt) { }
+
+  void Visit(const BreakStatement* stmt) { }
+
+  void Visit(const ReturnStatement* stmt) {
+    Accept(stmt->expr());
+  }
+
+  void Visit(const WithStatement* stmt) {
+    Accept(stmt->context());
+    Accept(stmt->body());
+  }
+
+  void Visit(const LabelledStatement* stmt) {
+    Accept(stmt->body());
+  }
+
+  void Visit(const SwitchStatement* stmt) {
+    Accept(stmt->expr());
+    BOOST_FOREACH(const CaseClause* const clause, stmt->clauses()) {
+      if (!clause->IsDefault()) {
+        Accept(clause->expr());
+      }
+      AcceptAll(clause->body());
+    }
+  }
+
+  void Visit(const ThrowStatement* stmt) {
+    Accept(stmt->expr());
+  }
+
+  void Visit(const TryStatement* stmt) {
+    Accept(stmt->body());
+    Accept(stmt->catch_block());
+    Accept(stmt->finally_block());
+  }
+
+  void Visit(const DebuggerStatement* stmt) { }
+
+  void Visit(const ExpressionStatement* stmt) {
+    Accept(stmt->expr());
+  }
+
+  void Visit(const Assignment* assign) {
+    Accept(assign->left());
+    Accept(assign->right());
+  }
+
+  void Visit(const BinaryOperation* binary) {
+    Accept(binary->left());
+    Accept(binary->right());
+  }
+
+  void Visit(const ConditionalExpression* cond) {
+    Accept(cond->cond());
+    Accept(cond->left());
+    Accept(cond->right());
+  }
+
+  void Visit(const UnaryOperation* unary) {
+    Accept(unary->expr());
+  }
+
+  void Visit(const PostfixExpression* postfix) {
+    Accept(postfix->expr());
+  }
+
+  void Visit(const StringLiteral* literal) { }
+
+  void Visit(const NumberLiteral* literal) { }
+
+  void Visit(const Identifier* ident) { }
+
+  void Visit(const ThisLiteral* literal) { }
+
+  void Visit(const NullLiteral* literal) { }
+
+  void Visit(const TrueLiteral* literal) { }
+
+  void Visit(const FalseLiteral* literal) { }
+
+  void Visit(const Undefined* literal) { }
+
+  void Visit(const RegExpLiteral* literal) { }
+
+  void Visit(const ArrayLiteral* literal) {
+    AcceptAll(literal->items());
+  }
+
+  void Visit(const ObjectLiteral* literal) {
+    using std::tr1::get;
+    BOOST_FOREACH(const ObjectLiteral::Property& prop,
+                  literal->properties()) {
+      Accept(get<2>(prop));
+    }
+  }
+
+  void Visit(const FunctionLiteral* func) {
+    AcceptAll(func->body());
+  }
+
+  void Visit(const IdentifierAccess* prop) {
+    Accept(prop->target());
+  }
+
+  void Visit(const IndexAccess* prop) {
+    Accept(prop->target());
+    Accept(prop->key());
+  }
+
+  void Visit(const FunctionCall* call) {
+    Accept(call->target());
+    AcceptAll(call->args());
+  }
+
+  void Visit(const ConstructorCall* call) {
+    Accept(call->target());
+    AcceptAll(call->args());
+  }
+
+};
+
+} }  // namespace iv::lv5
+#endif  // _IV_LV5_AST_WALKER_H_
@@ -0,0 +1,127 @@
+#ifndef _IV_LV5_BUDGET_H_
+#define _IV_LV5_BUDGET_H_
+#include <csignal>
+#include <ctime>
+#include <tr1/cstdint>
+#include <time.h>
+#include "noncopyable.h"
+#include "error.h"
+namespace iv {
+namespace lv5 {
+
+// execution budget of Context
+// interpreter consumes one tick on each loop iteration and function entry.
+// script is stopped with RangeError when
+//   - Interrupt() is called (from another thread, signal handler or timer)
+//   - tick limit is exceeded
+//   - CPU time limit is exceeded
+// CPU time is counted per thread, so Contexts running on other threads
+// are not charged, and Start() must be called on the thread running
+// the script. where thread CPU clock is not available, std::clock,
+// which is CPU time of whole process, is used.
+// once stopped, every following tick fails until Start() is called,
+// so script cannot continue by catching the error.
+// limits are checked once per kCheckInterval ticks,
+// fast path is a flag test and a counter decrement.
+class ExecutionBudget : private core::Noncopyable<ExecutionBudget>::type {
+ public:
+  static const uint32_t kCheckInterval = 1024;
+
+  ExecutionBudget()
+    : interrupted_(0),
+      exhausted_(false),
+      countdown_(kCheckInterval),
+      chunk_(kCheckInterval),
+      ticks_(0),
+      tick_limit_(0),
+      time_limit_(0),
+      start_(CPUTime()) {
+  }
+
+  inline void Consume(Error* error) {
+    if (interrupted_ || --countdown_ == 0) {
+      Check(error);
+    }
+  }
+
+  // async safe
+  void Interrupt() {
+    interrupted_ = 1;
+  }
+
+  // clears stop state and restarts counting
+  void Start() {
+    interrupted_ = 0;
+    exhausted_ = false;
+    ticks_ = 0;
+    start_ = CPUTime();
+    Rearm();
+  }
+
+  // 0 is unlimited
+  void set_tick_limit(uint64_t limit) {
+    tick_limit_ = limit;
+    ticks_ = ticks();
+    Rearm();
+  }
+
+  // milliseconds of CPU time, 0 is unlimited
+  void set_time_limit(uint64_t msec) {
+    time_limit_ = msec * 1000;
+  }
+
+  uint64_t ticks() const {
+    return ticks_ + (chunk_ - countdown_);
+  }
+
+ private:
+  // microseconds of CPU time consumed by current thread
+  static uint64_t CPUTime() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+      return static_cast<uint64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+    }
+#endif
+    return static_cast<uint64_t>(std::clock()) * 1000000 / CLOCKS_PER_SEC;
+  }
+
+  void Check(Error* error) {
+    if (interrupted_) {
+      error->Report(Error::Range,
+                    exhausted_ ?
+                    "execution budget exceeded" : "script interrupted");
+      return;
+    }
+    ticks_ += chunk_;
+    if ((tick_limit_ && ticks_ >= tick_limit_) ||
+        (time_limit_ && (CPUTime() - start_) >= time_limit_)) {
+      exhausted_ = true;
+      interrupted_ = 1;
+      error->Report(Error::Range, "execution budget exceeded");
+      return;
+    }
+    Rearm();
+  }
+
+  void Rearm() {
+    chunk_ = kCheckInterval;
+    if (tick_limit_ && ticks_ < tick_limit_ &&
+        tick_limit_ - ticks_ < chunk_) {
+      chunk_ = static_cast<uint32_t>(tick_limit_ - ticks_);
+    }
+    countdown_ = chunk_;
+  }
+
+  volatile std::sig_atomic_t interrupted_;
+  bool exhausted_;
+  uint32_t countdown_;
+  uint32_t chunk_;
+  uint64_t ticks_;
+  uint64_t tick_limit_;
+  uint64_t time_limit_;
+  uint64_t start_;
+};
+
+} }  // namespace iv::lv5
+#endif  // _IV_LV5_BUDGET_H_
@@ -0,0 +1,124 @@
+#ifndef _IV_LV5_CAPTURE_ANALYZER_H_
+#define _IV_LV5_CAPTURE_ANALYZER_H_
+#include <vector>
+#include <algorithm>
+#include <boost/foreach.hpp>
+#include "noncopyable.h"
+#include "jsast.h"
+#include "ast_walker.h"
+#include "factory.h"
+#include "symbol.h"
+namespace iv {
+namespace lv5 {
+
+// scope analysis of FunctionLiteral
+// collects names of variables that inner functions reference
+// from outer environment. environment of function is trimmed to
+// these bindings when the call is finished, because only
+// inner functions (and arguments object) can reach it after that.
+class CaptureAnalyzer
+  : public AstWalker,
+    private core::Noncopyable<CaptureAnalyzer>::type {
+ public:
+  typedef FunctionLiteral::Captures Captures;
+  typedef std::vector<Symbol> Names;
+
+  CaptureAnalyzer(Symbol eval_symbol, Symbol arguments_symbol)
+    : eval_symbol_(eval_symbol),
+      arguments_symbol_(arguments_symbol),
+      names_(),
+      depth_(0),
+      has_eval_(false),
+      has_inner_function_(false) {
+  }
+
+  // returns NULL if environment of func cannot be trimmed
+  const Captures* Analyze(const FunctionLiteral& func) {
+    BOOST_FOREACH(const Statement* const stmt, func.body()) {
+      stmt->Accept(this);
+    }
+    // direct eval may introduce closures referencing any variable
+    if (has_eval_) {
+      return NULL;
+    }
+    if (func.scope().needs_arguments()) {
+      // arguments object maps parameters to environment
+      BOOST_FOREACH(const Identifier* const ident, func.params()) {
+        names_.push_back(ident->symbol());
+      }
+      names_.push_back(arguments_symbol_);
+    } else if (!has_inner_function_) {
+      // environment is not reachable after the call
+      return NULL;
+    }
+    std::sort(names_.begin(), names_.end());
+    names_.erase(std::unique(names_.begin(), names_.end()), names_.end());
+    AstFactory* const factory = func.factory();
+    Captures* const captures = new (factory->New(sizeof(Captures)))
+        Captures(Captures::allocator_type(factory));
+    captures->assign(names_.begin(), names_.end());
+    return captures;
+  }
+
+ private:
+  void Visit(const Identifier* ident) {
+    const Symbol name = ident->symbol();
+    if (name == eval_symbol_) {
+      has_eval_ = true;
+    }
+    // references in this function itself are not captures
+    if (depth_) {
+      names_.push_back(name);
+    }
+  }
+
+  // free names of inner function are
+  // referenced names minus its own declarations
+  void Visit(const FunctionLiteral* func) {
+    has_inner_function_ = true;
+    Names outer;
+    outer.swap(names_);
+    ++depth_;
+    AcceptAll(func->body());
+    --depth_;
+    Names locals;
+    // name of function statement and named function expression is bound
+    // in its own environment. name of function declaration is bound
+    // in the enclosing environment, so it is a capture of outer function
+    const FunctionLiteral::DeclType type = func->type();
+    if (type == FunctionLiteral::STATEMENT ||
+        (type == FunctionLiteral::EXPRESSION && func->name())) {
+      locals.push_back(func->name()->symbol());
+    }
+    BOOST_FOREACH(const Identifier* const ident, func->params()) {
+      locals.push_back(ident->symbol());
+    }
+    BOOST_FOREACH(const Scope::Variable& var, func->scope().variables()) {
+      locals.push_back(var.first->symbol());
+    }
+    BOOST_FOREACH(const FunctionLiteral* const f,
+                  func->scope().function_declarations()) {
+      locals.push_back(f->name()->symbol());
+    }
+    if (func->scope().needs_arguments()) {
+      locals.push_back(arguments_symbol_);
+    }
+    std::sort(locals.begin(), locals.end());
+    BOOST_FOREACH(const Symbol name, names_) {
+      if (!std::binary_search(locals.begin(), locals.end(), name)) {
+        outer.push_back(name);
+      }
+    }
+    names_.swap(outer);
+  }
+
+  Symbol eval_symbol_;
+  Symbol arguments_symbol_;
+  Names names_;
+  std::size_t depth_;
+  bool has_eval_;
+  bool has_inner_function_;
+};
+
+} }  // namespace iv::lv5
+#endif  // _IV_LV5_CAPTURE_ANALYZER_H_
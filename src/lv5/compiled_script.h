@@ -0,0 +1,89 @@
+#ifndef _IV_LV5_COMPILED_SCRIPT_H_
+#define _IV_LV5_COMPILED_SCRIPT_H_
+#include <cassert>
+#include <string>
+#include "stringpiece.h"
+#include "noncopyable.h"
+#include "parser.h"
+#include "factory.h"
+#include "context.h"
+#include "jsast.h"
+#include "jsscript.h"
+#include "icu/source.h"
+namespace iv {
+namespace lv5 {
+
+// script parsed once and run by many Contexts
+//
+//   SymbolTable table;
+//   Context ctx1(&table), ctx2(&table);
+//   CompiledScript* script = CompiledScript::New(&ctx1, src, name, &err);
+//   ctx1.Run(script->Instantiate(&ctx1));
+//   ctx2.Run(script->Instantiate(&ctx2));
+//
+// symbols of AST are valid in Contexts sharing the SymbolTable of the
+// compiling Context. AST is made by shared AstFactory, which does not
+// cache Context dependent values, and lazy analyses are done in advance
+// by precompiling. so AST is not modified after New, and Contexts on
+// other threads can run it concurrently through their own JSScript.
+// CompiledScript and the SymbolTable must outlive all JSScripts
+// instantiated from it.
+class CompiledScript : private core::Noncopyable<CompiledScript>::type {
+ public:
+  ~CompiledScript() {
+    delete factory_;
+    delete source_;
+  }
+
+  // ctx is used only while compiling.
+  // returns NULL and stores message to error if parsing failed
+  static CompiledScript* New(Context* ctx,
+                             const core::StringPiece& str,
+                             const core::StringPiece& filename,
+                             std::string* error) {
+    icu::Source* const src = new icu::Source(str, filename);
+    AstFactory* const factory = new AstFactory(ctx, true);
+    core::Parser<AstFactory, icu::Source> parser(factory, src);
+    FunctionLiteral* const global = parser.ParseProgram();
+    if (!global) {
+      error->assign(parser.error());
+      delete factory;
+      delete src;
+      return NULL;
+    }
+    ctx->interp()->Precompile(global);
+    return new CompiledScript(global, factory, src, ctx->symbol_table());
+  }
+
+  JSScript* Instantiate(Context* ctx) const {
+    assert(ctx->symbol_table() == table_);
+    return JSGlobalScript::New(ctx, function_, factory_, source_);
+  }
+
+  const SymbolTable* symbol_table() const {
+    return table_;
+  }
+
+  const FunctionLiteral* function() const {
+    return function_;
+  }
+
+ private:
+  CompiledScript(FunctionLiteral* function,
+                 AstFactory* factory,
+                 icu::Source* source,
+                 const SymbolTable* table)
+    : function_(function),
+      factory_(factory),
+      source_(source),
+      table_(table) {
+  }
+
+  FunctionLiteral* function_;
+  AstFactory* factory_;
+  icu::Source* source_;
+  const SymbolTable* table_;
+};
+
+} }  // namespace iv::lv5
+#endif  // _IV_LV5_COMPILED_SCRIPT_H_
@@ -1,4 +1,6 @@
 #include <cmath>
+#include <cstdio>
+#include <tr1/array>
 #include "cstring"
 #include "ustring.h"
 #include "jsfunction.h"
@@ -24,6 +26,11 @@ const std::string toString_string("toString");
 const std::string valueOf_string("valueOf");
 const std::string prototype_string("prototype");
 const std::string constructor_string("constructor");
+const std::string String_string("String");
+const std::string Number_string("Number");
+const std::string Boolean_string("Boolean");
+const std::string Function_string("Function");
+const std::string Array_string("Array");
 
 class ScriptScope : private core::Noncopyable<ScriptScope>::type {
  public:
@@ -42,15 +49,20 @@ class ScriptScope : private core::Noncopyable<ScriptScope>::type {
 
 }  // namespace
 
-Context::Context()
+Context::Context(SymbolTable* table)
   : global_obj_(),
     throw_type_error_(),
     lexical_env_(NULL),
     variable_env_(NULL),
     global_env_(NULL),
     binding_(&global_obj_),
-    table_(),
+    table_((table) ? table : new SymbolTable()),
+    owns_table_(!table),
+    symbol_strings_(),
     interp_(),
+    stack_(),
+    frames_(),
+    budget_(),
     mode_(NORMAL),
     ret_(),
     target_(NULL),
@@ -58,6 +70,7 @@ Context::Context()
     builtins_(),
     strict_(false),
     generate_script_counter_(0),
+    eval_cache_(),
     random_engine_(random_engine_type(),
                    random_distribution_type(0, 1)),
     length_symbol_(Intern(length_string)),
@@ -69,7 +82,13 @@ Context::Context()
     valueOf_symbol_(Intern(valueOf_string)),
     prototype_symbol_(Intern(prototype_string)),
     constructor_symbol_(Intern(constructor_string)),
-    current_script_(NULL) {
+    String_symbol_(Intern(String_string)),
+    Number_symbol_(Intern(Number_string)),
+    Boolean_symbol_(Intern(Boolean_string)),
+    Function_symbol_(Intern(Function_string)),
+    Array_symbol_(Intern(Array_string)),
+    current_script_(NULL),
+    index_symbols_() {
   JSObjectEnv* const env = Interpreter::NewObjectEnvironment(this,
                                                              &global_obj_,
                                                              NULL);
@@ -85,28 +104,61 @@ Context::Context()
   Initialize();
 }
 
+Context::~Context() {
+  if (owns_table_) {
+    delete table_;
+  }
+}
+
 Symbol Context::Intern(const core::StringPiece& str) {
-  return table_.Lookup(str);
+  return table_->Lookup(str);
 }
 
 Symbol Context::Intern(const core::UStringPiece& str) {
-  return table_.Lookup(str);
+  return table_->Lookup(str);
 }
 
 Symbol Context::Intern(const Identifier& ident) {
   return ident.symbol();
 }
 
+// symbols of small array indexes are cached
+Symbol Context::InternIndex(uint32_t index) {
+  if (index < index_symbols_.size()) {
+    return index_symbols_[index];
+  }
+  std::tr1::array<char, 30> buffer;
+  if (index < kIndexSymbolCacheSize) {
+    while (index_symbols_.size() <= index) {
+      std::snprintf(buffer.data(), buffer.size(),
+                    "%lu",
+                    static_cast<unsigned long>(index_symbols_.size()));  // NOLINT
+      index_symbols_.push_back(Intern(buffer.data()));
+    }
+    return index_symbols_[index];
+  }
+  std::snprintf(buffer.data(), buffer.size(),
+                "%lu", static_cast<unsigned long>(index));  // NOLINT
+  return Intern(buffer.data());
+}
+
 double Context::Random() {
   return random_engine_();
 }
 
 JSString* Context::ToString(Symbol sym) {
-  return table_.ToString(this, sym);
+  if (symbol_strings_.size() <= sym) {
+    symbol_strings_.resize(sym + 1, NULL);
+  }
+  JSString*& str = symbol_strings_[sym];
+  if (!str) {
+    str = JSString::New(this, table_->GetContent(sym));
+  }
+  return str;
 }
 
 const core::UString& Context::GetContent(Symbol sym) const {
-  return table_.GetContent(sym);
+  return table_->GetContent(sym);
 }
 
 bool Context::InCurrentLabelSet(
@@ -126,6 +178,10 @@ bool Context::Run(JSScript* script) {
   return error_;
 }
 
+void Context::Precompile(JSScript* script) {
+  interp_.Precompile(script->function());
+}
+
 JSVal Context::ErrorVal() {
   return JSError::Detail(this, &error_);
 }
@@ -369,7 +425,6 @@ void Context::Initialize() {
 
   {
     // Array
-    // TODO(Constellation) more
     JSObject* const proto = JSObject::NewPlain(this);
     // section 15.4.2 The Array Constructor
     JSNativeFunction* const constructor =
@@ -404,6 +459,189 @@ void Context::Initialize() {
                        PropertyDescriptor::WRITABLE |
                        PropertyDescriptor::CONFIGURABLE),
         false, NULL);
+
+    // section 15.4.3.2 Array.isArray(arg)
+    constructor->DefineOwnProperty(
+        this, Intern("isArray"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayIsArray, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.2 Array.prototype.toString()
+    proto->DefineOwnProperty(
+        this, Intern("toString"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayToString, 0),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.3 Array.prototype.toLocaleString()
+    proto->DefineOwnProperty(
+        this, Intern("toLocaleString"),
+        DataDescriptor(
+            JSNativeFunction::New(
+                this, &runtime::ArrayToLocaleString, 0),
+            PropertyDescriptor::WRITABLE |
+            PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.4 Array.prototype.concat([item1[, item2[, ...]]])
+    proto->DefineOwnProperty(
+        this, Intern("concat"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayConcat, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.5 Array.prototype.join(separator)
+    proto->DefineOwnProperty(
+        this, Intern("join"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayJoin, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.6 Array.prototype.pop()
+    proto->DefineOwnProperty(
+        this, Intern("pop"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayPop, 0),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.7 Array.prototype.push([item1[, item2[, ...]]])
+    proto->DefineOwnProperty(
+        this, Intern("push"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayPush, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.8 Array.prototype.reverse()
+    proto->DefineOwnProperty(
+        this, Intern("reverse"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayReverse, 0),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.9 Array.prototype.shift()
+    proto->DefineOwnProperty(
+        this, Intern("shift"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayShift, 0),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.10 Array.prototype.slice(start, end)
+    proto->DefineOwnProperty(
+        this, Intern("slice"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArraySlice, 2),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.11 Array.prototype.sort(comparefn)
+    proto->DefineOwnProperty(
+        this, Intern("sort"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArraySort, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.12
+    // Array.prototype.splice(start, deleteCount[, item1[, ...]])
+    proto->DefineOwnProperty(
+        this, Intern("splice"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArraySplice, 2),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.13 Array.prototype.unshift([item1[, item2[, ...]]])
+    proto->DefineOwnProperty(
+        this, Intern("unshift"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayUnshift, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.14 Array.prototype.indexOf(searchElement[, fromIndex])
+    proto->DefineOwnProperty(
+        this, Intern("indexOf"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayIndexOf, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.15 Array.prototype.lastIndexOf(searchElement[, fromIndex])
+    proto->DefineOwnProperty(
+        this, Intern("lastIndexOf"),
+        DataDescriptor(
+            JSNativeFunction::New(
+                this, &runtime::ArrayLastIndexOf, 1),
+            PropertyDescriptor::WRITABLE |
+            PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.16 Array.prototype.every(callbackfn[, thisArg])
+    proto->DefineOwnProperty(
+        this, Intern("every"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayEvery, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.17 Array.prototype.some(callbackfn[, thisArg])
+    proto->DefineOwnProperty(
+        this, Intern("some"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArraySome, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.18 Array.prototype.forEach(callbackfn[, thisArg])
+    proto->DefineOwnProperty(
+        this, Intern("forEach"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayForEach, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.19 Array.prototype.map(callbackfn[, thisArg])
+    proto->DefineOwnProperty(
+        this, Intern("map"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayMap, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.20 Array.prototype.filter(callbackfn[, thisArg])
+    proto->DefineOwnProperty(
+        this, Intern("filter"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayFilter, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.21 Array.prototype.reduce(callbackfn[, initialValue])
+    proto->DefineOwnProperty(
+        this, Intern("reduce"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::ArrayReduce, 1),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.4.4.22 Array.prototype.reduceRight(callbackfn[, initialValue])
+    proto->DefineOwnProperty(
+        this, Intern("reduceRight"),
+        DataDescriptor(
+            JSNativeFunction::New(
+                this, &runtime::ArrayReduceRight, 1),
+            PropertyDescriptor::WRITABLE |
+            PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
   }
 
   {
@@ -531,6 +769,72 @@ void Context::Initialize() {
                          PropertyDescriptor::CONFIGURABLE),
           false, NULL);
     }
+    {
+      // section 15.5.4.11 String.prototype.replace(searchValue, replaceValue)
+      JSNativeFunction* const func =
+          JSNativeFunction::New(this, &runtime::StringReplace, 2);
+      proto->DefineOwnProperty(
+          this, Intern("replace"),
+          DataDescriptor(func,
+                         PropertyDescriptor::WRITABLE |
+                         PropertyDescriptor::CONFIGURABLE),
+          false, NULL);
+    }
+    {
+      // section 15.5.4.13 String.prototype.slice(start, end)
+      JSNativeFunction* const func =
+          JSNativeFunction::New(this, &runtime::StringSlice, 2);
+      proto->DefineOwnProperty(
+          this, Intern("slice"),
+          DataDescriptor(func,
+                         PropertyDescriptor::WRITABLE |
+                         PropertyDescriptor::CONFIGURABLE),
+          false, NULL);
+    }
+    {
+      // section 15.5.4.14 String.prototype.split(separator, limit)
+      JSNativeFunction* const func =
+          JSNativeFunction::New(this, &runtime::StringSplit, 2);
+      proto->DefineOwnProperty(
+          this, Intern("split"),
+          DataDescriptor(func,
+                         PropertyDescriptor::WRITABLE |
+                         PropertyDescriptor::CONFIGURABLE),
+          false, NULL);
+    }
+    {
+      // section 15.5.4.15 String.prototype.substring(start, end)
+      JSNativeFunction* const func =
+          JSNativeFunction::New(this, &runtime::StringSubstring, 2);
+      proto->DefineOwnProperty(
+          this, Intern("substring"),
+          DataDescriptor(func,
+                         PropertyDescriptor::WRITABLE |
+                         PropertyDescriptor::CONFIGURABLE),
+          false, NULL);
+    }
+    {
+      // section 15.5.4.16 String.prototype.toLowerCase()
+      JSNativeFunction* const func =
+          JSNativeFunction::New(this, &runtime::StringToLowerCase, 0);
+      proto->DefineOwnProperty(
+          this, Intern("toLowerCase"),
+          DataDescriptor(func,
+                         PropertyDescriptor::WRITABLE |
+                         PropertyDescriptor::CONFIGURABLE),
+          false, NULL);
+    }
+    {
+      // section 15.5.4.18 String.prototype.toUpperCase()
+      JSNativeFunction* const func =
+          JSNativeFunction::New(this, &runtime::StringToUpperCase, 0);
+      proto->DefineOwnProperty(
+          this, Intern("toUpperCase"),
+          DataDescriptor(func,
+                         PropertyDescriptor::WRITABLE |
+                         PropertyDescriptor::CONFIGURABLE),
+          false, NULL);
+    }
   }
 
   {
@@ -1201,6 +1505,35 @@ void Context::Initialize() {
         false, NULL);
   }
 
+  {
+    // section 15.12 JSON
+    JSObject* const json = JSObject::NewPlain(this);
+    json->set_prototype(obj_proto);
+    json->set_cls(JSString::NewAsciiString(this, "JSON"));
+    global_obj_.DefineOwnProperty(
+        this, Intern("JSON"),
+        DataDescriptor(json,
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.12.2 parse(text [, reviver])
+    json->DefineOwnProperty(
+        this, Intern("parse"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::JSONParse, 2),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+
+    // section 15.12.3 stringify(value [, replacer [, space]])
+    json->DefineOwnProperty(
+        this, Intern("stringify"),
+        DataDescriptor(JSNativeFunction::New(this, &runtime::JSONStringify, 3),
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::CONFIGURABLE),
+        false, NULL);
+  }
+
   {
     // Builtins
     // section 15.1.1.1 NaN
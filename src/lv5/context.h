@@ -3,6 +3,8 @@
 #include <tr1/unordered_map>
 #include <tr1/random>
 #include <tr1/type_traits>
+#include <tr1/cstdint>
+#include <vector>
 #include "xorshift.h"
 #include "stringpiece.h"
 #include "ustringpiece.h"
@@ -13,6 +15,7 @@
 #include "jsval.h"
 #include "jsobject.h"
 #include "jsfunction.h"
+#include "jstyped_function.h"
 #include "symboltable.h"
 #include "class.h"
 #include "interpreter.h"
@@ -20,11 +23,16 @@
 #include "jsast.h"
 #include "jsscript.h"
 #include "gc_template.h"
+#include "stack.h"
+#include "frame.h"
+#include "budget.h"
+#include "eval_cache.h"
 
 namespace iv {
 namespace lv5 {
 class Context : private core::Noncopyable<Context>::type {
  public:
+  static const uint32_t kIndexSymbolCacheSize = 1024;
   typedef iv::core::Xor128 random_engine_type;
   typedef std::tr1::uniform_real<double> random_distribution_type;
   typedef std::tr1::variate_generator<
@@ -36,11 +44,14 @@ class Context : private core::Noncopyable<Context>::type {
     RETURN,
     THROW
   };
-  Context();
-  const JSObject* global_obj() const {
+  // Contexts which run the same CompiledScript share table,
+  // otherwise Context has its own table
+  explicit Context(SymbolTable* table = NULL);
+  ~Context();
+  const JSGlobal* global_obj() const {
     return &global_obj_;
   }
-  JSObject* global_obj() {
+  JSGlobal* global_obj() {
     return &global_obj_;
   }
   JSEnv* lexical_env() const {
@@ -70,6 +81,15 @@ class Context : private core::Noncopyable<Context>::type {
   Interpreter* interp() {
     return &interp_;
   }
+  Stack* stack() {
+    return &stack_;
+  }
+  FrameStack* frames() {
+    return &frames_;
+  }
+  ExecutionBudget* budget() {
+    return &budget_;
+  }
   Mode mode() const {
     return mode_;
   }
@@ -134,8 +154,23 @@ class Context : private core::Noncopyable<Context>::type {
                                      func, strict_, &error_);
   }
 
+  // f is a function pointer with typed parameters,
+  // such as double(*)(double, double). see jstyped_function.h
+  template<typename Signature>
+  void DefineTypedFunction(Signature f,
+                           const core::StringPiece& func_name) {
+    JSFunction* const func = JSTypedFunction<Signature>::New(this, f);
+    const Symbol name = Intern(func_name);
+    variable_env_->CreateMutableBinding(this, name, false);
+    variable_env_->SetMutableBinding(this,
+                                     name,
+                                     func, strict_, &error_);
+  }
+
   void Initialize();
   bool Run(JSScript* script);
+  // for scripts run many times without change
+  void Precompile(JSScript* script);
 
   JSVal ErrorVal();
 
@@ -145,6 +180,7 @@ class Context : private core::Noncopyable<Context>::type {
   Symbol Intern(const core::StringPiece& str);
   Symbol Intern(const core::UStringPiece& str);
   Symbol Intern(const Identifier& ident);
+  Symbol InternIndex(uint32_t index);
   inline Symbol length_symbol() const {
     return length_symbol_;
   }
@@ -172,6 +208,21 @@ class Context : private core::Noncopyable<Context>::type {
   inline Symbol constructor_symbol() const {
     return constructor_symbol_;
   }
+  inline Symbol String_symbol() const {
+    return String_symbol_;
+  }
+  inline Symbol Number_symbol() const {
+    return Number_symbol_;
+  }
+  inline Symbol Boolean_symbol() const {
+    return Boolean_symbol_;
+  }
+  inline Symbol Function_symbol() const {
+    return Function_symbol_;
+  }
+  inline Symbol Array_symbol() const {
+    return Array_symbol_;
+  }
   JSNativeFunction* throw_type_error() {
     return &throw_type_error_;
   }
@@ -190,20 +241,32 @@ class Context : private core::Noncopyable<Context>::type {
       return false;
     }
   }
+  EvalCache* eval_cache() {
+    return &eval_cache_;
+  }
   double Random();
   JSString* ToString(Symbol sym);
   const core::UString& GetContent(Symbol sym) const;
+  SymbolTable* symbol_table() const {
+    return table_;
+  }
   bool InCurrentLabelSet(const AnonymousBreakableStatement* stmt) const;
   bool InCurrentLabelSet(const NamedOnlyBreakableStatement* stmt) const;
  private:
-  JSObject global_obj_;
+  JSGlobal global_obj_;
   JSNativeFunction throw_type_error_;
   JSEnv* lexical_env_;
   JSEnv* variable_env_;
   JSEnv* global_env_;
   JSVal binding_;
-  SymbolTable table_;
+  SymbolTable* table_;
+  bool owns_table_;
+  // JSString of symbol is created at first request and cached
+  TraceableVector<JSString*>::type symbol_strings_;
   Interpreter interp_;
+  Stack stack_;
+  FrameStack frames_;
+  ExecutionBudget budget_;
   Mode mode_;
   JSVal ret_;
   const BreakableStatement* target_;
@@ -211,6 +274,7 @@ class Context : private core::Noncopyable<Context>::type {
   GCHashMap<Symbol, Class>::type builtins_;
   bool strict_;
   std::size_t generate_script_counter_;
+  EvalCache eval_cache_;
   random_generator random_engine_;
   Symbol length_symbol_;
   Symbol eval_symbol_;
@@ -221,7 +285,13 @@ class Context : private core::Noncopyable<Context>::type {
   Symbol valueOf_symbol_;
   Symbol prototype_symbol_;
   Symbol constructor_symbol_;
+  Symbol String_symbol_;
+  Symbol Number_symbol_;
+  Symbol Boolean_symbol_;
+  Symbol Function_symbol_;
+  Symbol Array_symbol_;
   JSScript* current_script_;
+  std::vector<Symbol> index_symbols_;
 };
 } }  // namespace iv::lv5
 #endif  // _IV_LV5_CONTEXT_H_
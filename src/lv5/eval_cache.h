@@ -0,0 +1,142 @@
+#ifndef _IV_LV5_EVAL_CACHE_H_
+#define _IV_LV5_EVAL_CACHE_H_
+#include <list>
+#include <utility>
+#include <tr1/unordered_map>
+#include <gc/gc_allocator.h>
+#include "utils.h"
+#include "noncopyable.h"
+#include "jsstring.h"
+#include "jsscript.h"
+namespace iv {
+namespace lv5 {
+
+// LRU cache of compiled eval code
+// key is source string, strictness and kind of eval (direct or indirect).
+// cached script is parsed once and run repeatedly,
+// so AST and its caches (boilerplates, plans, ...) are reused.
+// capacity is total cost of cached entries in bytes. cached script owns
+// its AstFactory, so cost of an entry is given by caller and includes
+// factory and its arena, not only source string.
+class EvalCache : private core::Noncopyable<EvalCache>::type {
+ public:
+  static const std::size_t kDefaultCapacity = core::Size::MB * 32;
+
+  struct Key {
+    JSString* source;
+    bool strict;
+    bool direct;
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const {
+      return key.source->hash_value() ^
+          ((key.strict ? 2 : 0) | (key.direct ? 1 : 0));
+    }
+  };
+
+  struct KeyEqual {
+    bool operator()(const Key& lhs, const Key& rhs) const {
+      return lhs.strict == rhs.strict &&
+          lhs.direct == rhs.direct &&
+          *lhs.source == *rhs.source;
+    }
+  };
+
+  struct Entry {
+    Key key;
+    JSScript* script;
+    std::size_t cost;
+  };
+  typedef std::list<Entry, gc_allocator<Entry> > Entries;
+  typedef std::tr1::unordered_map<
+      Key, Entries::iterator, KeyHash, KeyEqual,
+      gc_allocator<std::pair<const Key, Entries::iterator> > > Table;
+
+  EvalCache()
+    : entries_(),
+      table_(),
+      size_(0),
+      capacity_(kDefaultCapacity),
+      hits_(0),
+      misses_(0) {
+  }
+
+  // returns NULL if not cached
+  JSScript* Lookup(JSString* source, bool strict, bool direct) {
+    const Key key = { source, strict, direct };
+    const Table::const_iterator it = table_.find(key);
+    if (it == table_.end()) {
+      ++misses_;
+      return NULL;
+    }
+    ++hits_;
+    // move to front, as most recently used
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->script;
+  }
+
+  void Insert(JSString* source, bool strict, bool direct,
+              JSScript* script, std::size_t cost) {
+    if (cost > capacity_) {
+      return;
+    }
+    const Key key = { source, strict, direct };
+    if (table_.find(key) != table_.end()) {
+      return;
+    }
+    const Entry entry = { key, script, cost };
+    entries_.push_front(entry);
+    table_.insert(std::make_pair(key, entries_.begin()));
+    size_ += cost;
+    Shrink();
+  }
+
+  void Clear() {
+    table_.clear();
+    entries_.clear();
+    size_ = 0;
+  }
+
+  std::size_t capacity() const {
+    return capacity_;
+  }
+
+  void set_capacity(std::size_t capacity) {
+    capacity_ = capacity;
+    Shrink();
+  }
+
+  std::size_t size() const {
+    return size_;
+  }
+
+  std::size_t hits() const {
+    return hits_;
+  }
+
+  std::size_t misses() const {
+    return misses_;
+  }
+
+ private:
+  // evicts least recently used entries
+  void Shrink() {
+    while (size_ > capacity_) {
+      const Entry& last = entries_.back();
+      size_ -= last.cost;
+      table_.erase(last.key);
+      entries_.pop_back();
+    }
+  }
+
+  Entries entries_;
+  Table table_;
+  std::size_t size_;
+  std::size_t capacity_;
+  std::size_t hits_;
+  std::size_t misses_;
+};
+
+} }  // namespace iv::lv5
+#endif  // _IV_LV5_EVAL_CACHE_H_
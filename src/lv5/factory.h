@@ -1,6 +1,7 @@
 #ifndef _IV_LV5_FACTORY_H_
 #define _IV_LV5_FACTORY_H_
 #include <vector>
+#include <gc/gc.h>
 #include "symbol.h"
 #include "alloc.h"
 #include "ast_factory.h"
@@ -8,6 +9,8 @@
 #include "ustringpiece.h"
 #include "context.h"
 #include "jsast.h"
+#include "jsstring.h"
+#include "gc_template.h"
 
 namespace iv {
 namespace lv5 {
@@ -18,26 +21,84 @@ class AstFactory
     public core::ast::BasicAstFactory<AstFactory> {
  public:
   typedef core::SpaceVector<AstFactory, RegExpLiteral*>::type DestReqs;
-  explicit AstFactory(Context* ctx)
+  typedef TraceableVector<JSString*>::type Strings;
+  typedef core::SpaceVector<AstFactory, JSObject**>::type Slots;
+  // shared factory creates AST which has no Context dependent cache,
+  // ctx is used only for creating literal values
+  explicit AstFactory(Context* ctx, bool shared = false)
     : core::Space<1>(),
       core::ast::BasicAstFactory<AstFactory>(),
       ctx_(ctx),
-      regexps_(DestReqs::allocator_type(this)) { }
+      shared_(shared),
+      regexps_(DestReqs::allocator_type(this)),
+      strings_(),
+      slots_(Slots::allocator_type(this)) { }
 
   ~AstFactory() {
-    for (DestReqs::const_iterator it = regexps_.begin(),
-         last = regexps_.end(); it != last; ++it) {
-      (*it)->~RegExpLiteral();
-    }
+    Release();
+  }
+
+  // drop all AST and rewind space, so that this factory can be reused
+  // for the next parse. AST created before Clear must not be used after
+  void Clear() {
+    Release();
+    DestReqs(DestReqs::allocator_type(this)).swap(regexps_);
+    Slots(Slots::allocator_type(this)).swap(slots_);
+    strings_.clear();
+    core::Space<1>::Clear();
+    CreateInstances();
   }
 
   template<typename Range>
   Identifier* NewIdentifier(const Range& range) {
     Identifier* ident = new (this) Identifier(range, this);
     ident->set_symbol(Intern(*ident));
+    if (shared_) {
+      ident->disable_cell_cache();
+    }
     return ident;
   }
 
+  FunctionLiteral* NewFunctionLiteral(FunctionLiteral::DeclType type) {
+    FunctionLiteral* const func = new (this) FunctionLiteral(type, this);
+    func->set_factory(this);
+    return func;
+  }
+
+  SwitchStatement* NewSwitchStatement(Expression* expr) {
+    SwitchStatement* const stmt = new (this) SwitchStatement(expr, this);
+    stmt->set_factory(this);
+    return stmt;
+  }
+
+  ArrayLiteral* NewArrayLiteral() {
+    ArrayLiteral* const expr = new (this) ArrayLiteral(this);
+    if (!shared_) {
+      expr->set_boilerplate_slot(NewSlot());
+    }
+    return expr;
+  }
+
+  ObjectLiteral* NewObjectLiteral() {
+    ObjectLiteral* const expr = new (this) ObjectLiteral(this);
+    if (!shared_) {
+      expr->set_boilerplate_slot(NewSlot());
+    }
+    return expr;
+  }
+
+  StringLiteral* NewStringLiteral(const std::vector<uc16>& buffer) {
+    StringLiteral* const str = new (this) StringLiteral(buffer, this);
+    str->set_string(NewString(str->value()));
+    return str;
+  }
+
+  Directivable* NewDirectivable(const std::vector<uc16>& buffer) {
+    Directivable* const str = new (this) Directivable(buffer, this);
+    str->set_string(NewString(str->value()));
+    return str;
+  }
+
   inline RegExpLiteral* NewRegExpLiteral(
       const std::vector<uc16>& content,
       const std::vector<uc16>& flags) {
@@ -52,11 +113,37 @@ class AstFactory
     }
   }
  private:
+  void Release() {
+    for (DestReqs::const_iterator it = regexps_.begin(),
+         last = regexps_.end(); it != last; ++it) {
+      (*it)->~RegExpLiteral();
+    }
+    for (Slots::const_iterator it = slots_.begin(),
+         last = slots_.end(); it != last; ++it) {
+      GC_FREE(*it);
+    }
+  }
   Symbol Intern(const Identifier& ident) {
     return ctx_->Intern(ident.value());
   }
+  // literal strings are kept alive while this factory (script) is alive
+  JSString* NewString(const core::UStringPiece& str) {
+    JSString* const res = JSString::New(ctx_, str);
+    strings_.push_back(res);
+    return res;
+  }
+  JSObject** NewSlot() {
+    JSObject** const slot = static_cast<JSObject**>(
+        GC_MALLOC_UNCOLLECTABLE(sizeof(JSObject*)));  // NOLINT
+    *slot = NULL;
+    slots_.push_back(slot);
+    return slot;
+  }
   Context* ctx_;
+  bool shared_;
   DestReqs regexps_;
+  Strings strings_;
+  Slots slots_;
 };
 } }  // namespace iv::lv5
 #endif  // _IV_LV5_FACTORY_H_
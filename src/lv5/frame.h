@@ -0,0 +1,68 @@
+#ifndef _IV_LV5_FRAME_H_
+#define _IV_LV5_FRAME_H_
+#include <cstddef>
+#include <cassert>
+#include "jsval.h"
+#include "jsenv.h"
+#include "gc_template.h"
+#include "noncopyable.h"
+namespace iv {
+namespace lv5 {
+
+// execution state of caller,
+// saved when function code or eval code is entered
+struct Frame {
+  JSEnv* lexical_env;
+  JSEnv* variable_env;
+  JSVal this_binding;
+  bool strict;
+};
+
+// frame stack
+// frames are placed in traced heap memory instead of C++ stack,
+// and depth of JS calls is limited by max_depth,
+// which is checked when function code is entered.
+class FrameStack : private core::Noncopyable<FrameStack>::type {
+ public:
+  typedef TraceableVector<Frame>::type Frames;
+  static const std::size_t kDefaultMaxDepth = 1024;
+
+  FrameStack()
+    : frames_(),
+      max_depth_(kDefaultMaxDepth) {
+  }
+
+  inline void Push(const Frame& frame) {
+    frames_.push_back(frame);
+  }
+
+  inline Frame Pop() {
+    assert(!frames_.empty());
+    const Frame frame = frames_.back();
+    frames_.pop_back();
+    return frame;
+  }
+
+  inline bool IsExhausted() const {
+    return frames_.size() >= max_depth_;
+  }
+
+  inline std::size_t size() const {
+    return frames_.size();
+  }
+
+  std::size_t max_depth() const {
+    return max_depth_;
+  }
+
+  void set_max_depth(std::size_t depth) {
+    max_depth_ = depth;
+  }
+
+ private:
+  Frames frames_;
+  std::size_t max_depth_;
+};
+
+} }  // namespace iv::lv5
+#endif  // _IV_LV5_FRAME_H_
@@ -16,6 +16,13 @@ struct GCVector {
   typedef std::vector<T, gc_allocator<T> > type;
 };
 
+// uncollectable but traced by GC,
+// use for roots held by non GC objects
+template<typename T>
+struct TraceableVector {
+  typedef std::vector<T, traceable_allocator<T> > type;
+};
+
 template<typename T1, typename T2>
 struct GCMap {
   typedef std::map<T1,
@@ -33,9 +33,13 @@ typedef detail::InteractiveData<core::None> InteractiveData;
 class Interactive {
  public:
   Interactive()
-    : ctx_() {
+    : ctx_(),
+      factory_(NULL) {
     ctx_.DefineFunction(&lv5::Print, "print", 1);
   }
+  ~Interactive() {
+    delete factory_;
+  }
   int Run() {
     std::string buffer;
     while (true) {
@@ -87,7 +91,11 @@ class Interactive {
   JSEvalScript<icu::Source>* Parse(const std::string& text, bool* recover) {
     std::tr1::shared_ptr<icu::Source> src(
         new icu::Source(text, InteractiveData::kOrigin));
-    AstFactory* const factory = new AstFactory(&ctx_);
+    // factory of failed (or incomplete) input is cleared and reused,
+    // factory of parsed script is owned by that script
+    AstFactory* const factory =
+        (factory_) ? factory_ : new AstFactory(&ctx_);
+    factory_ = NULL;
     core::Parser<AstFactory, icu::Source> parser(factory, src.get());
     parser.set_strict(ctx_.IsStrict());
     const FunctionLiteral* const eval = parser.ParseProgram();
@@ -97,13 +105,15 @@ class Interactive {
       } else {
         std::cerr << parser.error() << std::endl;
       }
-      delete factory;
+      factory->Clear();
+      factory_ = factory;
       return NULL;
     } else {
       return JSEvalScript<icu::Source>::New(&ctx_, eval, factory, src);
     }
   }
   Context ctx_;
+  AstFactory* factory_;
 };
 
 } }  // namespace iv::lv5
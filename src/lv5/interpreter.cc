@@ -2,10 +2,13 @@
 #include <cassert>
 #include <cmath>
 #include <iostream>  // NOLINT
+#include <vector>
+#include <algorithm>
 #include <tr1/tuple>
 #include <tr1/array>
 #include <boost/foreach.hpp>
 #include "token.h"
+#include "conversions.h"
 #include "hint.h"
 #include "interpreter.h"
 #include "jsreference.h"
@@ -20,7 +23,11 @@
 #include "jsarray.h"
 #include "context.h"
 #include "jsast.h"
+#include "factory.h"
+#include "ast_walker.h"
+#include "capture_analyzer.h"
 #include "runtime_global.h"
+#include "runtime_math.h"
 
 namespace iv {
 namespace lv5 {
@@ -80,11 +87,14 @@ Interpreter::ContextSwitcher::ContextSwitcher(Context* ctx,
                                               JSEnv* var,
                                               const JSVal& binding,
                                               bool strict)
-  : prev_lex_(ctx->lexical_env()),
-    prev_var_(ctx->variable_env()),
-    prev_binding_(ctx->this_binding()),
-    prev_strict_(strict),
-    ctx_(ctx) {
+  : ctx_(ctx) {
+  const Frame frame = {
+    ctx->lexical_env(),
+    ctx->variable_env(),
+    ctx->this_binding(),
+    ctx->IsStrict()
+  };
+  ctx_->frames()->Push(frame);
   ctx_->set_lexical_env(lex);
   ctx_->set_variable_env(var);
   ctx_->set_this_binding(binding);
@@ -92,10 +102,11 @@ Interpreter::ContextSwitcher::ContextSwitcher(Context* ctx,
 }
 
 Interpreter::ContextSwitcher::~ContextSwitcher() {
-  ctx_->set_lexical_env(prev_lex_);
-  ctx_->set_variable_env(prev_var_);
-  ctx_->set_this_binding(prev_binding_);
-  ctx_->set_strict(prev_strict_);
+  const Frame frame = ctx_->frames()->Pop();
+  ctx_->set_lexical_env(frame.lexical_env);
+  ctx_->set_variable_env(frame.variable_env);
+  ctx_->set_this_binding(frame.this_binding);
+  ctx_->set_strict(frame.strict);
 }
 
 Interpreter::LexicalEnvSwitcher::LexicalEnvSwitcher(Context* context,
@@ -120,7 +131,10 @@ Interpreter::StrictSwitcher::~StrictSwitcher() {
 }
 
 Interpreter::Interpreter()
-  : ctx_(NULL) {
+  : ctx_(NULL),
+    loop_profile_(false),
+    loops_(),
+    loop_map_() {
 }
 
 
@@ -128,6 +142,96 @@ Interpreter::~Interpreter() {
 }
 
 
+namespace {
+
+const FunctionLiteral::Captures* GetCaptures(Context* ctx,
+                                             const FunctionLiteral* func) {
+  if (!func->IsCaptureAnalyzed()) {
+    CaptureAnalyzer analyzer(ctx->eval_symbol(), ctx->arguments_symbol());
+    func->set_captures(analyzer.Analyze(*func));
+  }
+  return func->captures();
+}
+
+// after the call, bindings which are not captured by
+// inner functions or arguments object are released from environment
+class EnvironmentTrimmer : private core::Noncopyable<EnvironmentTrimmer>::type {
+ public:
+  EnvironmentTrimmer(JSDeclEnv* env,
+                     const FunctionLiteral::Captures* captures)
+    : env_(env),
+      captures_(captures) {
+  }
+
+  ~EnvironmentTrimmer() {
+    if (captures_) {
+      JSDeclEnv::Record& record = env_->record();
+      for (JSDeclEnv::Record::iterator it = record.begin();
+           it != record.end();) {
+        if (std::binary_search(captures_->begin(),
+                               captures_->end(), it->first)) {
+          ++it;
+        } else {
+          record.erase(it++);
+        }
+      }
+    }
+  }
+
+ private:
+  JSDeclEnv* env_;
+  const FunctionLiteral::Captures* captures_;
+};
+
+// functions called this many times are compiled to declaration plan
+const std::size_t kHotFunctionCallCount = 16;
+
+const FunctionLiteral::Plan* CompileDeclarationPlan(
+    Context* ctx, const FunctionLiteral* func) {
+  std::vector<Symbol> bound;
+  BOOST_FOREACH(const Identifier* const ident, func->params()) {
+    bound.push_back(ident->symbol());
+  }
+  const Scope& scope = func->scope();
+  BOOST_FOREACH(const FunctionLiteral* const f,
+                scope.function_declarations()) {
+    bound.push_back(f->name()->symbol());
+  }
+  if (scope.needs_arguments()) {
+    // bound by arguments object, or by parameter of the same name
+    bound.push_back(ctx->arguments_symbol());
+  }
+  std::sort(bound.begin(), bound.end());
+  bound.erase(std::unique(bound.begin(), bound.end()), bound.end());
+  AstFactory* const factory = func->factory();
+  FunctionLiteral::Plan* const plan =
+      new (factory) FunctionLiteral::Plan(factory);
+  std::vector<Symbol> vars;
+  BOOST_FOREACH(const Scope::Variable& var, scope.variables()) {
+    const Symbol dn = var.first->symbol();
+    if (!std::binary_search(bound.begin(), bound.end(), dn) &&
+        std::find(vars.begin(), vars.end(), dn) == vars.end()) {
+      vars.push_back(dn);
+    }
+  }
+  plan->variables().assign(vars.begin(), vars.end());
+  // and name of function itself
+  plan->set_binding_count(bound.size() + vars.size() + 1);
+  func->set_plan(plan);
+  return plan;
+}
+
+const FunctionLiteral::Plan* GetDeclarationPlan(Context* ctx,
+                                                const FunctionLiteral* func) {
+  if (func->plan() ||
+      func->IncrementCallCount() != kHotFunctionCallCount) {
+    return func->plan();
+  }
+  return CompileDeclarationPlan(ctx, func);
+}
+
+}  // namespace anonymous
+
 // section 13.2.1 [[Call]]
 void Interpreter::CallCode(
     JSCodeFunction* code,
@@ -143,6 +247,12 @@ void Interpreter::CallCode(
       this_value.set_value(obj);
     }
   }
+  ctx_->budget()->Consume(CHECK_IN_STMT);
+  if (ctx_->frames()->IsExhausted()) {
+    ctx_->error()->Report(Error::Range, "maximum call stack size exceeded");
+    RETURN_STMT(Context::THROW, JSUndefined, NULL);
+  }
+
   // section 10.5 Declaration Binding Instantiation
   const Scope& scope = code->code()->scope();
 
@@ -150,36 +260,37 @@ void Interpreter::CallCode(
   JSDeclEnv* const env = NewDeclarativeEnvironment(ctx_, code->scope());
   const ContextSwitcher switcher(ctx_, env, env, this_value,
                                  code->IsStrict());
+  const EnvironmentTrimmer trimmer(env, GetCaptures(ctx_, code->code()));
+  const FunctionLiteral::Plan* const plan =
+      GetDeclarationPlan(ctx_, code->code());
+  if (plan) {
+    env->Reserve(plan->binding_count());
+  }
 
   // step 2
   const bool configurable_bindings = false;
 
   // step 4
   {
-    const Arguments::JSVals& arguments = args.args();
-    const std::size_t arg_count = arguments.size();
+    const std::size_t arg_count = args.size();
     std::size_t n = 0;
     BOOST_FOREACH(const Identifier* const ident,
                   code->code()->params()) {
-      ++n;
-      const Symbol arg_name = ctx_->Intern(*ident);
+      const Symbol arg_name = ident->symbol();
       if (!env->HasBinding(arg_name)) {
         env->CreateMutableBinding(ctx_, arg_name, configurable_bindings);
       }
-      if (n > arg_count) {
-        env->SetMutableBinding(ctx_, arg_name,
-                               JSUndefined, ctx_->IsStrict(), CHECK_IN_STMT);
-      } else {
-        env->SetMutableBinding(ctx_, arg_name,
-                               arguments[n-1], ctx_->IsStrict(), CHECK_IN_STMT);
-      }
+      env->SetMutableBinding(ctx_, arg_name,
+                             (n < arg_count) ? args[n] : JSUndefined,
+                             ctx_->IsStrict(), CHECK_IN_STMT);
+      ++n;
     }
   }
 
   // step 5
   BOOST_FOREACH(const FunctionLiteral* const f,
                 scope.function_declarations()) {
-    const Symbol fn = ctx_->Intern(*(f->name()));
+    const Symbol fn = f->name()->symbol();
     EVAL_IN_STMT(f);
     const JSVal fo = ctx_->ret();
     if (!env->HasBinding(fn)) {
@@ -189,9 +300,10 @@ void Interpreter::CallCode(
   }
 
   // step 6, 7
-  // TODO(Constellation) code check (function)
+  // arguments object is not observable
+  // if function body doesn't reference "arguments" or "eval"
   const Symbol arguments_symbol = ctx_->arguments_symbol();
-  if (!env->HasBinding(arguments_symbol)) {
+  if (scope.needs_arguments() && !env->HasBinding(arguments_symbol)) {
     JSArguments* const args_obj = JSArguments::New(ctx_,
                                                    code,
                                                    code->code()->params(),
@@ -210,12 +322,19 @@ void Interpreter::CallCode(
   }
 
   // step 8
-  BOOST_FOREACH(const Scope::Variable& var, scope.variables()) {
-    const Symbol dn = ctx_->Intern(*(var.first));
-    if (!env->HasBinding(dn)) {
+  if (plan) {
+    // bindings are initialized to undefined
+    BOOST_FOREACH(const Symbol dn, plan->variables()) {
       env->CreateMutableBinding(ctx_, dn, configurable_bindings);
-      env->SetMutableBinding(ctx_, dn,
-                             JSUndefined, ctx_->IsStrict(), CHECK_IN_STMT);
+    }
+  } else {
+    BOOST_FOREACH(const Scope::Variable& var, scope.variables()) {
+      const Symbol dn = var.first->symbol();
+      if (!env->HasBinding(dn)) {
+        env->CreateMutableBinding(ctx_, dn, configurable_bindings);
+        env->SetMutableBinding(ctx_, dn,
+                               JSUndefined, ctx_->IsStrict(), CHECK_IN_STMT);
+      }
     }
   }
 
@@ -223,7 +342,7 @@ void Interpreter::CallCode(
     const FunctionLiteral::DeclType type = code->code()->type();
     if (type == FunctionLiteral::STATEMENT ||
         (type == FunctionLiteral::EXPRESSION && code->name())) {
-      const Symbol name = ctx_->Intern(*(code->name()));
+      const Symbol name = code->name()->symbol();
       if (!env->HasBinding(name)) {
         env->CreateImmutableBinding(name);
         env->InitializeImmutableBinding(name, code);
@@ -253,7 +372,7 @@ void Interpreter::Run(const FunctionLiteral* global, bool is_eval) {
   const StrictSwitcher switcher(ctx_, global->strict());
   BOOST_FOREACH(const FunctionLiteral* const f,
                 scope.function_declarations()) {
-    const Symbol fn = ctx_->Intern(*(f->name()));
+    const Symbol fn = f->name()->symbol();
     EVAL_IN_STMT(f);
     JSVal fo = ctx_->ret();
     if (!env->HasBinding(fn)) {
@@ -263,7 +382,7 @@ void Interpreter::Run(const FunctionLiteral* global, bool is_eval) {
   }
 
   BOOST_FOREACH(const Scope::Variable& var, scope.variables()) {
-    const Symbol dn = ctx_->Intern(*(var.first));
+    const Symbol dn = var.first->symbol();
     if (!env->HasBinding(dn)) {
       env->CreateMutableBinding(ctx_, dn, configurable_bindings);
       env->SetMutableBinding(ctx_, dn,
@@ -373,9 +492,15 @@ void Interpreter::Visit(const IfStatement* stmt) {
 
 
 void Interpreter::Visit(const DoWhileStatement* stmt) {
+  LoopProfile* const profile =
+      (loop_profile_) ? ProfileLoopEntry(stmt) : NULL;
   JSVal value;
   bool iterating = true;
   while (iterating) {
+    ctx_->budget()->Consume(CHECK_IN_STMT);
+    if (profile) {
+      ++profile->iterations;
+    }
     EVAL_IN_STMT(stmt->body());
     if (!ctx_->ret().IsUndefined()) {
       value = ctx_->ret();
@@ -400,12 +525,18 @@ void Interpreter::Visit(const DoWhileStatement* stmt) {
 
 
 void Interpreter::Visit(const WhileStatement* stmt) {
+  LoopProfile* const profile =
+      (loop_profile_) ? ProfileLoopEntry(stmt) : NULL;
   JSVal value;
   while (true) {
     EVAL_IN_STMT(stmt->cond());
     const JSVal expr = GetValue(ctx_->ret(), CHECK_IN_STMT);
     const bool val = expr.ToBoolean(CHECK_IN_STMT);
     if (val) {
+      ctx_->budget()->Consume(CHECK_IN_STMT);
+      if (profile) {
+        ++profile->iterations;
+      }
       EVAL_IN_STMT(stmt->body());
       if (!ctx_->ret().IsUndefined()) {
         value = ctx_->ret();
@@ -432,6 +563,8 @@ void Interpreter::Visit(const ForStatement* stmt) {
     EVAL_IN_STMT(stmt->init());
     GetValue(ctx_->ret(), CHECK_IN_STMT);
   }
+  LoopProfile* const profile =
+      (loop_profile_) ? ProfileLoopEntry(stmt) : NULL;
   JSVal value;
   while (true) {
     if (stmt->cond()) {
@@ -442,6 +575,10 @@ void Interpreter::Visit(const ForStatement* stmt) {
         RETURN_STMT(Context::NORMAL, value, NULL);
       }
     }
+    ctx_->budget()->Consume(CHECK_IN_STMT);
+    if (profile) {
+      ++profile->iterations;
+    }
     EVAL_IN_STMT(stmt->body());
     if (!ctx_->ret().IsUndefined()) {
       value = ctx_->ret();
@@ -464,47 +601,63 @@ void Interpreter::Visit(const ForStatement* stmt) {
 }
 
 
+// section 12.6.4 The for-in Statement
 void Interpreter::Visit(const ForInStatement* stmt) {
+  // LeftHandSideExpression is evaluated in each iteration,
+  // VariableDeclarationNoIn is evaluated only once
+  const Expression* lhs_expr;
+  if (const VariableStatement* const var =
+      stmt->each()->AsVariableStatement()) {
+    EVAL_IN_STMT(var);
+    lhs_expr = var->decls().front()->name();
+  } else {
+    assert(stmt->each()->AsExpressionStatement());
+    lhs_expr = stmt->each()->AsExpressionStatement()->expr();
+  }
   EVAL_IN_STMT(stmt->enumerable());
   const JSVal expr = GetValue(ctx_->ret(), CHECK_IN_STMT);
   if (expr.IsNull() || expr.IsUndefined()) {
     RETURN_STMT(Context::NORMAL, JSUndefined, NULL);
   }
   JSObject* const obj = expr.ToObject(ctx_, CHECK_IN_STMT);
+  LoopProfile* const profile =
+      (loop_profile_) ? ProfileLoopEntry(stmt) : NULL;
+
+  // names are collected before iteration,
+  // so body can add or delete properties safely.
+  std::vector<Symbol> names;
+  obj->GetEnumerablePropertyNames(&names);
+
   JSVal value;
-  JSObject* current = obj;
-  do {
-    BOOST_FOREACH(const JSObject::Properties::value_type& set,
-                  current->table()) {
-      if (!set.second.IsEnumerable()) {
-        continue;
-      }
-      JSVal rhs(ctx_->ToString(set.first));
-      EVAL_IN_STMT(stmt->each());
-      if (stmt->each()->AsVariableStatement()) {
-        const Identifier* const ident =
-            stmt->each()->AsVariableStatement()->decls().front()->name();
-        EVAL_IN_STMT(ident);
-      }
-      JSVal lhs = ctx_->ret();
-      PutValue(lhs, rhs, CHECK_IN_STMT);
-      EVAL_IN_STMT(stmt->body());
-      if (!ctx_->ret().IsUndefined()) {
-        value = ctx_->ret();
+  for (std::vector<Symbol>::const_iterator it = names.begin(),
+       last = names.end(); it != last; ++it) {
+    // property deleted before visited is not visited
+    if (!obj->HasProperty(*it)) {
+      continue;
+    }
+    ctx_->budget()->Consume(CHECK_IN_STMT);
+    if (profile) {
+      ++profile->iterations;
+    }
+    const JSVal rhs(ctx_->ToString(*it));
+    EVAL_IN_STMT(lhs_expr);
+    const JSVal lhs = ctx_->ret();
+    PutValue(lhs, rhs, CHECK_IN_STMT);
+    EVAL_IN_STMT(stmt->body());
+    if (!ctx_->ret().IsUndefined()) {
+      value = ctx_->ret();
+    }
+    if (!ctx_->IsMode<Context::CONTINUE>() ||
+        !ctx_->InCurrentLabelSet(stmt)) {
+      if (ctx_->IsMode<Context::BREAK>() &&
+          ctx_->InCurrentLabelSet(stmt)) {
+        RETURN_STMT(Context::NORMAL, value, NULL);
       }
-      if (!ctx_->IsMode<Context::CONTINUE>() ||
-          !ctx_->InCurrentLabelSet(stmt)) {
-        if (ctx_->IsMode<Context::BREAK>() &&
-            ctx_->InCurrentLabelSet(stmt)) {
-          RETURN_STMT(Context::NORMAL, value, NULL);
-        }
-        if (!ctx_->IsMode<Context::NORMAL>()) {
-          ABRUPT();
-        }
+      if (!ctx_->IsMode<Context::NORMAL>()) {
+        ABRUPT();
       }
     }
-    current = current->prototype();
-  } while (current);
+  }
   RETURN_STMT(Context::NORMAL, value, NULL);
 }
 
@@ -554,12 +707,119 @@ void Interpreter::Visit(const LabelledStatement* stmt) {
 }
 
 
+namespace {
+
+typedef core::ast::SwitchJumpTable<AstFactory> SwitchJumpTable;
+
+// build jump table at first execution
+// if all case labels are number or string literals
+const SwitchJumpTable* GetJumpTable(const SwitchStatement* stmt) {
+  typedef SwitchStatement::CaseClauses CaseClauses;
+  if (stmt->IsJumpTableAnalyzed()) {
+    return stmt->jump_table();
+  }
+  const CaseClauses& clauses = stmt->clauses();
+  for (CaseClauses::const_iterator it = clauses.begin(),
+       last = clauses.end(); it != last; ++it) {
+    if (!(*it)->IsDefault() &&
+        !(*it)->expr()->AsNumberLiteral() &&
+        !(*it)->expr()->AsStringLiteral()) {
+      stmt->set_jump_table(NULL);
+      return NULL;
+    }
+  }
+  SwitchJumpTable* const table =
+      new (stmt->factory()) SwitchJumpTable(stmt->factory());
+  table->set_default_index(clauses.size());
+  std::size_t index = 0;
+  for (CaseClauses::const_iterator it = clauses.begin(),
+       last = clauses.end(); it != last; ++it, ++index) {
+    const CaseClause* const clause = *it;
+    if (clause->IsDefault()) {
+      table->set_default_index(index);
+    } else if (const NumberLiteral* const num =
+               clause->expr()->AsNumberLiteral()) {
+      table->AddNumber(num->value(), index);
+    } else {
+      table->AddString(clause->expr()->AsStringLiteral()->value(), index);
+    }
+  }
+  stmt->set_jump_table(table);
+  return table;
+}
+
+// performs analyses which are done lazily at execution in advance,
+// so script runs without warm-up
+class Precompiler : public AstWalker {
+ public:
+  explicit Precompiler(Context* ctx) : ctx_(ctx) { }
+
+ private:
+  void Visit(const FunctionLiteral* func) {
+    GetCaptures(ctx_, func);
+    if (!func->plan()) {
+      CompileDeclarationPlan(ctx_, func);
+    }
+    AcceptAll(func->body());
+  }
+
+  void Visit(const SwitchStatement* stmt) {
+    GetJumpTable(stmt);
+    AstWalker::Visit(stmt);
+  }
+
+  Context* ctx_;
+};
+
+}  // namespace anonymous
+
+void Interpreter::Precompile(const FunctionLiteral* global) {
+  Precompiler precompiler(ctx_);
+  BOOST_FOREACH(const Statement* const stmt, global->body()) {
+    stmt->Accept(&precompiler);
+  }
+}
+
+// section 12.11 The switch Statement
 void Interpreter::Visit(const SwitchStatement* stmt) {
   EVAL_IN_STMT(stmt->expr());
   const JSVal cond = GetValue(ctx_->ret(), CHECK_IN_STMT);
   // Case Block
   JSVal value;
-  {
+  if (const SwitchJumpTable* const table = GetJumpTable(stmt)) {
+    // labels have no side effect,
+    // so jump to first matched clause (or default) directly
+    typedef SwitchStatement::CaseClauses CaseClauses;
+    const CaseClauses& clauses = stmt->clauses();
+    std::size_t index;
+    bool found = false;
+    if (cond.IsNumber()) {
+      found = table->LookupNumber(cond.number(), &index);
+    } else if (cond.IsString()) {
+      found = table->LookupString(cond.string()->ToPiece(), &index);
+    }
+    if (!found) {
+      index = table->default_index();
+    }
+    bool finalize = false;
+    for (CaseClauses::const_iterator it = clauses.begin() + index,
+         last = clauses.end(); it != last; ++it) {
+      BOOST_FOREACH(const Statement* const st, (*it)->body()) {
+        EVAL_IN_STMT(st);
+        if (!ctx_->ret().IsUndefined()) {
+          value = ctx_->ret();
+        }
+        if (!ctx_->IsMode<Context::NORMAL>()) {
+          ctx_->ret() = value;
+          finalize = true;
+          break;
+        }
+      }
+      if (finalize) {
+        break;
+      }
+    }
+  } else {
     typedef SwitchStatement::CaseClauses CaseClauses;
     bool found = false;
     bool default_found = false;
@@ -645,7 +905,7 @@ void Interpreter::Visit(const TryStatement* stmt) {
       ctx_->error()->Clear();
       JSEnv* const old_env = ctx_->lexical_env();
       JSEnv* const catch_env = NewDeclarativeEnvironment(ctx_, old_env);
-      const Symbol name = ctx_->Intern(*(stmt->catch_name()));
+      const Symbol name = stmt->catch_name()->symbol();
       catch_env->CreateMutableBinding(ctx_, name, false);
       catch_env->SetMutableBinding(ctx_, name, ex, false, CHECK_IN_STMT);
       {
@@ -1213,7 +1473,7 @@ void Interpreter::Visit(const PostfixExpression* postfix) {
 
 
 void Interpreter::Visit(const StringLiteral* str) {
-  ctx_->Return(JSString::New(ctx_, str->value()));
+  ctx_->Return(str->string());
 }
 
 
@@ -1224,11 +1484,30 @@ void Interpreter::Visit(const NumberLiteral* num) {
 
 void Interpreter::Visit(const Identifier* ident) {
   // section 10.3.1 Identifier Resolution
-  JSEnv* const env = ctx_->lexical_env();
-  ctx_->Return(
-      GetIdentifierReference(env,
-                             ctx_->Intern(*ident),
-                             ctx_->IsStrict()));
+  const Symbol name = ident->symbol();
+  const bool strict = ctx_->IsStrict();
+  JSEnv* const global_env = ctx_->global_env();
+  JSEnv* env = ctx_->lexical_env();
+  while (env && env != global_env) {
+    if (env->HasBinding(name)) {
+      ctx_->Return(JSReference::New(ctx_, env, name, strict));
+      return;
+    }
+    env = env->outer();
+  }
+  if (env) {
+    // global own data property is resolved through cached property cell
+    PropertyCell* cell = ident->cell();
+    if (!cell || !cell->desc()) {
+      cell = ctx_->global_obj()->LookupCell(name);
+      ident->set_cell(cell);
+    }
+    if (cell) {
+      ctx_->Return(JSReference::New(ctx_, env, name, strict, cell));
+      return;
+    }
+  }
+  ctx_->Return(GetIdentifierReference(env, name, strict));
 }
 
 
@@ -1262,21 +1541,46 @@ void Interpreter::Visit(const RegExpLiteral* regexp) {
 }
 
 
+namespace {
+
+// literal value which has no side effect and is immutable
+inline bool IsConstantLiteral(const Expression* expr) {
+  return expr->AsNumberLiteral() ||
+      expr->AsStringLiteral() ||
+      expr->AsTrueLiteral() ||
+      expr->AsFalseLiteral() ||
+      expr->AsNullLiteral() ||
+      expr->AsUndefined();
+}
+
+}  // namespace anonymous
+
 void Interpreter::Visit(const ArrayLiteral* literal) {
   // when in parse phase, have already removed last elision.
+  if (const JSObject* const boilerplate = literal->boilerplate()) {
+    // clone boilerplate, and fill only non constant items
+    JSArray* const ary = JSArray::New(ctx_);
+    ary->InitializeFromBoilerplate(*boilerplate);
+    uint32_t current = 0;
+    BOOST_FOREACH(const Expression* const expr, literal->items()) {
+      if (expr && !IsConstantLiteral(expr)) {
+        EVAL(expr);
+        const JSVal value = GetValue(ctx_->ret(), CHECK);
+        ary->SetOwnDataValue(ctx_->InternIndex(current), value);
+      }
+      ++current;
+    }
+    ctx_->Return(ary);
+    return;
+  }
   JSArray* const ary = JSArray::New(ctx_);
-  std::size_t current = 0;
-  std::tr1::array<char, 30> buffer;
+  uint32_t current = 0;
   BOOST_FOREACH(const Expression* const expr, literal->items()) {
     if (expr) {
       EVAL(expr);
       const JSVal value = GetValue(ctx_->ret(), CHECK);
-      std::snprintf(buffer.data(), buffer.size(),
-                    "%lu",
-                    static_cast<unsigned long>(current));  // NOLINT
-      const Symbol index = ctx_->Intern(buffer.data());
       ary->DefineOwnProperty(
-          ctx_, index,
+          ctx_, ctx_->InternIndex(current),
           DataDescriptor(value, PropertyDescriptor::WRITABLE |
                                 PropertyDescriptor::ENUMERABLE |
                                 PropertyDescriptor::CONFIGURABLE),
@@ -1286,19 +1590,51 @@ void Interpreter::Visit(const ArrayLiteral* literal) {
   }
   ary->Put(ctx_, ctx_->length_symbol(),
            current, false, CHECK);
+
+  // create boilerplate, values of non constant items are not retained
+  JSObject* const boilerplate = JSObject::NewPlain(ctx_);
+  boilerplate->InitializeFromBoilerplate(*ary);
+  current = 0;
+  BOOST_FOREACH(const Expression* const expr, literal->items()) {
+    if (expr && !IsConstantLiteral(expr)) {
+      boilerplate->SetOwnDataValue(ctx_->InternIndex(current), JSUndefined);
+    }
+    ++current;
+  }
+  literal->set_boilerplate(boilerplate);
   ctx_->Return(ary);
 }
 
 
 void Interpreter::Visit(const ObjectLiteral* literal) {
   using std::tr1::get;
+  if (const JSObject* const boilerplate = literal->boilerplate()) {
+    // clone boilerplate, and fill only non constant properties
+    JSObject* const obj = JSObject::NewPlain(ctx_);
+    obj->InitializeFromBoilerplate(*boilerplate);
+    BOOST_FOREACH(const ObjectLiteral::Property& prop,
+                  literal->properties()) {
+      const Expression* const expr = get<2>(prop);
+      if (!IsConstantLiteral(expr)) {
+        EVAL(expr);
+        const JSVal value = GetValue(ctx_->ret(), CHECK);
+        obj->SetOwnDataValue(get<1>(prop)->symbol(), value);
+      }
+    }
+    ctx_->Return(obj);
+    return;
+  }
+
   JSObject* const obj = JSObject::New(ctx_);
+  // boilerplate is available only if all properties are
+  // data properties with distinct names
+  bool cacheable = true;
 
   // section 11.1.5
   BOOST_FOREACH(const ObjectLiteral::Property& prop, literal->properties()) {
     const ObjectLiteral::PropertyDescriptorType type(get<0>(prop));
     const Identifier* const ident = get<1>(prop);
-    const Symbol name = ctx_->Intern(*(ident));
+    const Symbol name = ident->symbol();
     PropertyDescriptor desc;
     if (type == ObjectLiteral::DATA) {
       EVAL(get<2>(prop));
@@ -1308,6 +1644,7 @@ void Interpreter::Visit(const ObjectLiteral* literal) {
                             PropertyDescriptor::ENUMERABLE |
                             PropertyDescriptor::CONFIGURABLE);
     } else {
+      cacheable = false;
       EVAL(get<2>(prop));
       if (type == ObjectLiteral::GET) {
         desc = AccessorDescriptor(ctx_->ret().object(), NULL,
@@ -1326,6 +1663,19 @@ void Interpreter::Visit(const ObjectLiteral* literal) {
     // So, in interpreter phase, there's nothing to do.
     obj->DefineOwnProperty(ctx_, name, desc, false, CHECK);
   }
+
+  if (cacheable && obj->table().size() == literal->properties().size()) {
+    // create boilerplate, values of non constant properties are not retained
+    JSObject* const boilerplate = JSObject::NewPlain(ctx_);
+    boilerplate->InitializeFromBoilerplate(*obj);
+    BOOST_FOREACH(const ObjectLiteral::Property& prop,
+                  literal->properties()) {
+      if (!IsConstantLiteral(get<2>(prop))) {
+        boilerplate->SetOwnDataValue(get<1>(prop)->symbol(), JSUndefined);
+      }
+    }
+    literal->set_boilerplate(boilerplate);
+  }
   ctx_->Return(obj);
 }
 
@@ -1341,7 +1691,7 @@ void Interpreter::Visit(const IdentifierAccess* prop) {
   EVAL(prop->target());
   const JSVal base_value = GetValue(ctx_->ret(), CHECK);
   base_value.CheckObjectCoercible(CHECK);
-  const Symbol sym = ctx_->Intern(*(prop->key()));
+  const Symbol sym = prop->key()->symbol();
   ctx_->Return(
       JSReference::New(ctx_, base_value, sym, ctx_->IsStrict()));
 }
@@ -1378,6 +1728,17 @@ void Interpreter::Visit(const FunctionCall* call) {
     ctx_->error()->Report(Error::Type, "not callable object");
     return;
   }
+  {
+    // Math builtins on numbers are executed inline
+    const JSNativeFunction* const native =
+        func.object()->AsCallable()->AsNativeFunction();
+    double res;
+    if (native &&
+        runtime::MathIntrinsic(native->function(), args, &res)) {
+      ctx_->Return(res);
+      return;
+    }
+  }
   if (target.IsReference()) {
     const JSReference* const ref = target.reference();
     if (ref->IsPropertyReference()) {
@@ -1430,7 +1791,7 @@ void Interpreter::Visit(const ConstructorCall* call) {
   JSFunction* const constructor = func.object()->AsCallable();
   JSObject* const obj = JSObject::New(ctx_);
   const JSVal proto = constructor->Get(
-      ctx_, ctx_->Intern("prototype"), CHECK);
+      ctx_, ctx_->prototype_symbol(), CHECK);
   if (proto.IsObject()) {
     obj->set_prototype(proto.object());
   }
@@ -1444,6 +1805,55 @@ void Interpreter::Visit(const ConstructorCall* call) {
 }
 
 
+// section 8.7.1 special [[Get]]
+// wrapper object of primitive base is not created,
+// own properties of String object (length, index) are served from string
+// and others are looked up from prototype directly
+JSVal Interpreter::GetPrimitiveProperty(const JSVal& base,
+                                        Symbol name, Error* error) {
+  JSObject* proto;
+  if (base.IsString()) {
+    const JSString* const str = base.string();
+    // section 15.5.5.1 length
+    if (name == ctx_->length_symbol()) {
+      return static_cast<double>(str->size());
+    }
+    // section 15.5.5.2 [[GetOwnProperty]] ( P )
+    uint32_t index;
+    if (core::ConvertToUInt32(ctx_->GetContent(name), &index) &&
+        index < str->size()) {
+      return JSString::New(ctx_, core::UStringPiece(str->data() + index, 1));
+    }
+    proto = ctx_->Cls(ctx_->String_symbol()).prototype;
+  } else if (base.IsNumber()) {
+    proto = ctx_->Cls(ctx_->Number_symbol()).prototype;
+  } else {
+    assert(base.IsBoolean());
+    proto = ctx_->Cls(ctx_->Boolean_symbol()).prototype;
+  }
+  const PropertyDescriptor desc = proto->GetProperty(name);
+  if (desc.IsEmpty()) {
+    return JSUndefined;
+  }
+  if (desc.IsDataDescriptor()) {
+    return desc.AsDataDescriptor()->data();
+  } else {
+    assert(desc.IsAccessorDescriptor());
+    const AccessorDescriptor* const ac = desc.AsAccessorDescriptor();
+    if (ac->get()) {
+      const JSVal res = ac->get()->AsCallable()->Call(
+          Arguments(ctx_, base), error);
+      if (*error) {
+        return JSUndefined;
+      }
+      return res;
+    } else {
+      return JSUndefined;
+    }
+  }
+}
+
+
 // section 8.7.1 GetValue
 JSVal Interpreter::GetValue(const JSVal& val, Error* error) {
   if (!val.IsReference()) {
@@ -1458,31 +1868,7 @@ JSVal Interpreter::GetValue(const JSVal& val, Error* error) {
   }
   if (ref->IsPropertyReference()) {
     if (ref->HasPrimitiveBase()) {
-      // section 8.7.1 special [[Get]]
-      const JSObject* const o = base->ToObject(ctx_, error);
-      if (*error) {
-        return JSUndefined;
-      }
-      const PropertyDescriptor desc = o->GetProperty(ref->GetReferencedName());
-      if (desc.IsEmpty()) {
-        return JSUndefined;
-      }
-      if (desc.IsDataDescriptor()) {
-        return desc.AsDataDescriptor()->data();
-      } else {
-        assert(desc.IsAccessorDescriptor());
-        const AccessorDescriptor* const ac = desc.AsAccessorDescriptor();
-        if (ac->get()) {
-          const JSVal res = ac->get()->AsCallable()->Call(
-              Arguments(ctx_, *base), error);
-          if (*error) {
-            return JSUndefined;
-          }
-          return res;
-        } else {
-          return JSUndefined;
-        }
-      }
+      return GetPrimitiveProperty(*base, ref->GetReferencedName(), error);
     } else {
       const JSVal res = base->object()->Get(ctx_,
                                             ref->GetReferencedName(), error);
@@ -1493,6 +1879,11 @@ JSVal Interpreter::GetValue(const JSVal& val, Error* error) {
     }
     return JSUndefined;
   } else {
+    if (const PropertyCell* const cell = ref->cell()) {
+      if (const PropertyDescriptor* const desc = cell->desc()) {
+        return desc->AsDataDescriptor()->data();
+      }
+    }
     const JSVal res = base->environment()->GetBindingValue(
         ctx_, ref->GetReferencedName(), ref->IsStrictReference(), error);
     if (*error) {
@@ -1566,6 +1957,13 @@ void Interpreter::PutValue(const JSVal& val, const JSVal& w,
     }
   } else {
     assert(base->environment());
+    if (const PropertyCell* const cell = ref->cell()) {
+      PropertyDescriptor* const desc = cell->desc();
+      if (desc && desc->IsWritable()) {
+        desc->AsDataDescriptor()->set_value(w);
+        return;
+      }
+    }
     base->environment()->SetMutableBinding(ctx_,
                                            ref->GetReferencedName(), w,
                                            ref->IsStrictReference(), ERRCHECK);
@@ -1576,37 +1974,6 @@ void Interpreter::PutValue(const JSVal& val, const JSVal& w,
 #undef ERRCHECK
 
 
-bool Interpreter::StrictEqual(const JSVal& lhs, const JSVal& rhs) {
-  if (lhs.type() != rhs.type()) {
-    return false;
-  }
-  if (lhs.IsUndefined()) {
-    return true;
-  }
-  if (lhs.IsNull()) {
-    return true;
-  }
-  if (lhs.IsNumber()) {
-    const double& lhsv = lhs.number();
-    const double& rhsv = rhs.number();
-    if (std::isnan(lhsv) || std::isnan(rhsv)) {
-      return false;
-    }
-    return lhsv == rhsv;
-  }
-  if (lhs.IsString()) {
-    return *(lhs.string()) == *(rhs.string());
-  }
-  if (lhs.IsBoolean()) {
-    return lhs.boolean() == rhs.boolean();
-  }
-  if (lhs.IsObject()) {
-    return lhs.object() == rhs.object();
-  }
-  return false;
-}
-
-
 #define ABSTRACT_CHECK\
   CHECK_TO_WITH(error, false)
 
@@ -1733,6 +2100,69 @@ JSObjectEnv* Interpreter::NewObjectEnvironment(Context* ctx,
 }
 
 
+namespace {
+
+// loops iterated this many times are reported as hot
+const std::size_t kHotLoopIterationCount = 1000;
+
+const char* LoopKind(const IterationStatement* stmt) {
+  if (stmt->AsDoWhileStatement()) {
+    return "do-while";
+  } else if (stmt->AsWhileStatement()) {
+    return "while";
+  } else if (stmt->AsForInStatement()) {
+    return "for-in";
+  } else {
+    return "for";
+  }
+}
+
+}  // namespace anonymous
+
+// record is found by loop node. address of released AST may be reused
+// by another loop, so record is also matched by line and kind
+Interpreter::LoopProfile* Interpreter::ProfileLoopEntry(
+    const IterationStatement* stmt) {
+  const std::size_t line = stmt->line_number();
+  const char* const kind = LoopKind(stmt);
+  std::tr1::unordered_map<const IterationStatement*, std::size_t>::iterator
+      it = loop_map_.find(stmt);
+  if (it == loop_map_.end() ||
+      loops_[it->second].line != line || loops_[it->second].kind != kind) {
+    const LoopProfile record = { line, kind, 0, 0 };
+    loop_map_[stmt] = loops_.size();
+    loops_.push_back(record);
+    it = loop_map_.find(stmt);
+  }
+  LoopProfile* const profile = &loops_[it->second];
+  ++profile->entries;
+  return profile;
+}
+
+void Interpreter::DumpLoopProfile(std::ostream* os) const {
+  std::size_t total = 0;
+  std::size_t hot = 0;
+  BOOST_FOREACH(const LoopProfile& loop, loops_) {
+    total += loop.iterations;
+    if (loop.iterations >= kHotLoopIterationCount) {
+      hot += loop.iterations;
+    }
+  }
+  *os << "loop profile: " << loops_.size() << " loops, "
+      << total << " iterations, "
+      << ((total) ? (100.0 * hot / total) : 0.0)
+      << "% in hot loops" << std::endl;
+  BOOST_FOREACH(const LoopProfile& loop, loops_) {
+    *os << "  line " << loop.line
+        << " " << loop.kind
+        << ": " << loop.entries << " entries, "
+        << loop.iterations << " iterations"
+        << ((loop.iterations >= kHotLoopIterationCount) ? " (hot)" : "")
+        << std::endl;
+  }
+}
+
+
 JSReference* Interpreter::GetIdentifierReference(JSEnv* lex,
                                                  Symbol name, bool strict) {
   JSEnv* env = lex;
@@ -1,5 +1,9 @@
 #ifndef IV_LV5_INTERPRETER_H_
 #define IV_LV5_INTERPRETER_H_
+#include <iosfwd>
+#include <vector>
+#include <deque>
+#include <tr1/unordered_map>
 #include "ast_visitor.h"
 #include "noncopyable.h"
 #include "ast.h"
@@ -27,6 +31,9 @@ class Interpreter : private core::Noncopyable<Interpreter>::type,
   Interpreter();
   ~Interpreter();
   void Run(const FunctionLiteral* global, bool is_eval);
+  // compiles analyses of functions and switch statements of script,
+  // which are otherwise done at their first executions
+  void Precompile(const FunctionLiteral* global);
 
   Context* context() const {
     return ctx_;
@@ -37,6 +44,20 @@ class Interpreter : private core::Noncopyable<Interpreter>::type,
   void CallCode(JSCodeFunction* code, const Arguments& args,
                 Error* error);
 
+  // loop profile counts entries and iterations of each loop.
+  // line and kind are copied into the record, so profile is valid
+  // after AST of the loop (e.g. eval code) is released
+  struct LoopProfile {
+    std::size_t line;
+    const char* kind;
+    std::size_t entries;
+    std::size_t iterations;
+  };
+  void set_loop_profile(bool val) {
+    loop_profile_ = val;
+  }
+  void DumpLoopProfile(std::ostream* os) const;
+
   static JSDeclEnv* NewDeclarativeEnvironment(Context* ctx, JSEnv* env);
   static JSObjectEnv* NewObjectEnvironment(Context* ctx,
                                            JSObject* val, JSEnv* env);
@@ -50,10 +71,6 @@ class Interpreter : private core::Noncopyable<Interpreter>::type,
                     bool strict);
     ~ContextSwitcher();
    private:
-    JSEnv* prev_lex_;
-    JSEnv* prev_var_;
-    JSVal prev_binding_;
-    bool prev_strict_;
     Context* ctx_;
   };
 
@@ -120,14 +137,19 @@ class Interpreter : private core::Noncopyable<Interpreter>::type,
   void Visit(const ConstructorCall* call);
 
   bool InCurrentLabelSet(const BreakableStatement* stmt);
-  bool StrictEqual(const JSVal& lhs, const JSVal& rhs);
   bool AbstractEqual(const JSVal& lhs, const JSVal& rhs, Error* error);
   CompareKind Compare(const JSVal& lhs, const JSVal& rhs, Error* error);
   JSVal GetValue(const JSVal& val, Error* error);
+  JSVal GetPrimitiveProperty(const JSVal& base, Symbol name, Error* error);
   void PutValue(const JSVal& val, const JSVal& w, Error* error);
   JSReference* GetIdentifierReference(JSEnv* lex, Symbol name, bool strict);
+  LoopProfile* ProfileLoopEntry(const IterationStatement* stmt);
 
   Context* ctx_;
+  bool loop_profile_;
+  // deque keeps records in place while inner loops are added
+  std::deque<LoopProfile> loops_;
+  std::tr1::unordered_map<const IterationStatement*, std::size_t> loop_map_;
 };
 
 } }  // namespace iv::lv5
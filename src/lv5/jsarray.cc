@@ -19,7 +19,7 @@ JSArray::JSArray(Context* ctx, std::size_t len)
   : JSObject(),
     length_(len) {
   JSObject::DefineOwnProperty(ctx, ctx->length_symbol(),
-                              DataDescriptor(0.0,
+                              DataDescriptor(static_cast<double>(len),
                                              PropertyDescriptor::WRITABLE),
                                              false, ctx->error());
 }
@@ -81,13 +81,10 @@ bool JSArray::DefineOwnProperty(Context* ctx,
       if (!succeeded) {
         return false;
       }
-      std::tr1::array<char, 80> buffer;
       while (new_len < old_len) {
         old_len -= 1;
-        const char* const str = core::DoubleToCString(old_len,
-                                                      buffer.data(),
-                                                      buffer.size());
-        const Symbol now_index = ctx->Intern(str);
+        const Symbol now_index =
+            ctx->InternIndex(static_cast<uint32_t>(old_len));
         // see Eratta
         const bool delete_succeeded = Delete(now_index, false, res);
         if (*res) {
@@ -150,7 +147,7 @@ bool JSArray::DefineOwnProperty(Context* ctx,
 
 JSArray* JSArray::New(Context* ctx) {
   JSArray* const ary = new JSArray(ctx, 0);
-  const Class& cls = ctx->Cls("Array");
+  const Class& cls = ctx->Cls(ctx->Array_symbol());
   ary->set_cls(cls.name);
   ary->set_prototype(cls.prototype);
   return ary;
@@ -158,10 +155,27 @@ JSArray* JSArray::New(Context* ctx) {
 
 JSArray* JSArray::New(Context* ctx, std::size_t n) {
   JSArray* const ary = new JSArray(ctx, n);
-  const Class& cls = ctx->Cls("Array");
+  const Class& cls = ctx->Cls(ctx->Array_symbol());
   ary->set_cls(cls.name);
   ary->set_prototype(cls.prototype);
   return ary;
 }
 
+JSArray* JSArray::New(Context* ctx, const Vector& values) {
+  JSArray* const ary = New(ctx, values.size());
+  std::size_t index = 0;
+  for (Vector::const_iterator it = values.begin(),
+       last = values.end(); it != last; ++it, ++index) {
+    ary->table_[ctx->InternIndex(index)] =
+        DataDescriptor(*it,
+                       PropertyDescriptor::WRITABLE |
+                       PropertyDescriptor::ENUMERABLE |
+                       PropertyDescriptor::CONFIGURABLE);
+  }
+  ary->table_[ctx->length_symbol()] =
+      DataDescriptor(static_cast<double>(values.size()),
+                     PropertyDescriptor::WRITABLE);
+  return ary;
+}
+
 } }  // namespace iv::lv5
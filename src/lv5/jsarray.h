@@ -19,6 +19,9 @@ class JSArray : public JSObject {
 
   static JSArray* New(Context* ctx);
   static JSArray* New(Context* ctx, std::size_t n);
+  // elements are placed to property table directly,
+  // without [[DefineOwnProperty]] of array
+  static JSArray* New(Context* ctx, const Vector& values);
 
  private:
   std::size_t length_;
@@ -1,7 +1,11 @@
 #ifndef _IV_LV5_JSAST_H_
 #define _IV_LV5_JSAST_H_
 #include <vector>
+#include <functional>
+#include <tr1/unordered_map>
 #include "uchar.h"
+#include "space.h"
+#include "ustringpiece.h"
 #include "jsregexp_impl.h"
 #include "ast.h"
 #include "symbol.h"
@@ -9,6 +13,9 @@
 namespace iv {
 namespace lv5 {
 class AstFactory;
+class JSString;
+class JSObject;
+class PropertyCell;
 }  // namespace iv::lv5
 namespace core {
 namespace ast {
@@ -17,14 +24,280 @@ template<>
 class IdentifierBase<iv::lv5::AstFactory>
   : public Inherit<iv::lv5::AstFactory, kIdentifier> {
  public:
+  IdentifierBase() : cell_(NULL), cacheable_(true) { }
   void set_symbol(iv::lv5::Symbol sym) {
     sym_ = sym;
   }
   iv::lv5::Symbol symbol() const {
     return sym_;
   }
+  // property cell of global binding found at last resolution
+  iv::lv5::PropertyCell* cell() const {
+    return cell_;
+  }
+  void set_cell(iv::lv5::PropertyCell* cell) const {
+    if (cacheable_) {
+      cell_ = cell;
+    }
+  }
+  // cell belongs to one global object,
+  // so it is not cached in AST shared by Contexts
+  void disable_cell_cache() {
+    cacheable_ = false;
+  }
  private:
   iv::lv5::Symbol sym_;
+  mutable iv::lv5::PropertyCell* cell_;
+  bool cacheable_;
+};
+
+// JSString value of StringLiteral is created once by AstFactory
+// and shared by every evaluation of this literal
+template<>
+class StringLiteralBase<iv::lv5::AstFactory>
+  : public Inherit<iv::lv5::AstFactory, kStringLiteral> {
+ public:
+  StringLiteralBase() : str_(NULL) { }
+  void set_string(iv::lv5::JSString* str) {
+    str_ = str;
+  }
+  iv::lv5::JSString* string() const {
+    return str_;
+  }
+ private:
+  iv::lv5::JSString* str_;
+};
+
+// boilerplate object of ObjectLiteral and ArrayLiteral
+// is created at first evaluation and cloned after that.
+// slot is traced by GC and released by AstFactory.
+// AST shared by Contexts has no slot, because boilerplate
+// has prototype of one Context.
+class LiteralBoilerplate {
+ public:
+  LiteralBoilerplate() : slot_(NULL) { }
+  void set_boilerplate_slot(iv::lv5::JSObject** slot) {
+    slot_ = slot;
+  }
+  iv::lv5::JSObject* boilerplate() const {
+    return slot_ ? *slot_ : NULL;
+  }
+  void set_boilerplate(iv::lv5::JSObject* obj) const {
+    if (slot_) {
+      *slot_ = obj;
+    }
+  }
+ private:
+  iv::lv5::JSObject** slot_;
+};
+
+template<>
+class ArrayLiteralBase<iv::lv5::AstFactory>
+  : public Inherit<iv::lv5::AstFactory, kArrayLiteral>,
+    public LiteralBoilerplate {
+};
+
+template<>
+class ObjectLiteralBase<iv::lv5::AstFactory>
+  : public Inherit<iv::lv5::AstFactory, kObjectLiteral>,
+    public LiteralBoilerplate {
+};
+
+// jump table of SwitchStatement whose case labels are all
+// number or string literals. maps label to index of first matched clause.
+template<typename Factory>
+class SwitchJumpTable : public SpaceObject {
+ public:
+  struct UStringPieceHash
+    : public std::unary_function<UStringPiece, std::size_t> {
+    std::size_t operator()(const UStringPiece& x) const {
+      return StringToHash(x);
+    }
+  };
+  typedef std::tr1::unordered_map<
+      double,
+      std::size_t,
+      std::tr1::hash<double>,
+      std::equal_to<double>,
+      SpaceAllocator<Factory,
+                     std::pair<const double, std::size_t> > > NumberTable;
+  typedef std::tr1::unordered_map<
+      UStringPiece,
+      std::size_t,
+      UStringPieceHash,
+      std::equal_to<UStringPiece>,
+      SpaceAllocator<Factory,
+                     std::pair<const UStringPiece, std::size_t> > >
+      StringTable;
+
+  explicit SwitchJumpTable(Factory* factory)
+    : numbers_(0, typename NumberTable::hasher(),
+               typename NumberTable::key_equal(),
+               typename NumberTable::allocator_type(factory)),
+      strings_(0, typename StringTable::hasher(),
+               typename StringTable::key_equal(),
+               typename StringTable::allocator_type(factory)),
+      default_index_(0) {
+  }
+
+  // first clause wins if labels are duplicated
+  void AddNumber(double val, std::size_t index) {
+    // +0 and -0 are same label
+    numbers_.insert(std::make_pair((val == 0) ? 0.0 : val, index));
+  }
+
+  void AddString(const UStringPiece& val, std::size_t index) {
+    strings_.insert(std::make_pair(val, index));
+  }
+
+  // returns false if not found
+  bool LookupNumber(double val, std::size_t* index) const {
+    const typename NumberTable::const_iterator it =
+        numbers_.find((val == 0) ? 0.0 : val);
+    if (it == numbers_.end()) {
+      return false;
+    }
+    *index = it->second;
+    return true;
+  }
+
+  bool LookupString(const UStringPiece& val, std::size_t* index) const {
+    const typename StringTable::const_iterator it = strings_.find(val);
+    if (it == strings_.end()) {
+      return false;
+    }
+    *index = it->second;
+    return true;
+  }
+
+  // index of default clause, or clauses size if not exists
+  void set_default_index(std::size_t index) {
+    default_index_ = index;
+  }
+
+  std::size_t default_index() const {
+    return default_index_;
+  }
+
+ private:
+  NumberTable numbers_;
+  StringTable strings_;
+  std::size_t default_index_;
+};
+
+// jump table is built at first execution,
+// and allocated in space of AstFactory which created this statement
+template<>
+class SwitchStatementBase<iv::lv5::AstFactory>
+  : public Inherit<iv::lv5::AstFactory, kSwitchStatement> {
+ public:
+  SwitchStatementBase()
+    : factory_(NULL),
+      table_(NULL),
+      analyzed_(false) {
+  }
+  void set_factory(iv::lv5::AstFactory* factory) {
+    factory_ = factory;
+  }
+  iv::lv5::AstFactory* factory() const {
+    return factory_;
+  }
+  bool IsJumpTableAnalyzed() const {
+    return analyzed_;
+  }
+  // NULL if labels are not constant
+  const SwitchJumpTable<iv::lv5::AstFactory>* jump_table() const {
+    return table_;
+  }
+  void set_jump_table(
+      const SwitchJumpTable<iv::lv5::AstFactory>* table) const {
+    analyzed_ = true;
+    table_ = table;
+  }
+ private:
+  iv::lv5::AstFactory* factory_;
+  mutable const SwitchJumpTable<iv::lv5::AstFactory>* table_;
+  mutable bool analyzed_;
+};
+
+// section 10.5 Declaration Binding Instantiation compiled for hot function.
+// variables which are not bound by parameters, function declarations
+// or arguments object are precomputed, so no lookup is needed
+// and environment record is sized at once.
+template<typename Factory>
+class DeclarationPlan : public SpaceObject {
+ public:
+  typedef typename SpaceVector<Factory, iv::lv5::Symbol>::type Symbols;
+  explicit DeclarationPlan(Factory* factory)
+    : variables_(typename Symbols::allocator_type(factory)),
+      binding_count_(0) {
+  }
+  const Symbols& variables() const {
+    return variables_;
+  }
+  Symbols& variables() {
+    return variables_;
+  }
+  // upper bound of bindings created at call
+  std::size_t binding_count() const {
+    return binding_count_;
+  }
+  void set_binding_count(std::size_t count) {
+    binding_count_ = count;
+  }
+ private:
+  Symbols variables_;
+  std::size_t binding_count_;
+};
+
+// names of variables of this function referenced by inner functions.
+// computed at first call and allocated in space of AstFactory,
+// NULL if environment of this function must be retained as is.
+// declaration plan is compiled when call count reaches threshold.
+template<>
+class FunctionLiteralBase<iv::lv5::AstFactory>
+  : public Inherit<iv::lv5::AstFactory, kFunctionLiteral> {
+ public:
+  typedef SpaceVector<iv::lv5::AstFactory, iv::lv5::Symbol>::type Captures;
+  typedef DeclarationPlan<iv::lv5::AstFactory> Plan;
+  FunctionLiteralBase()
+    : factory_(NULL),
+      captures_(NULL),
+      plan_(NULL),
+      call_count_(0),
+      analyzed_(false) {
+  }
+  void set_factory(iv::lv5::AstFactory* factory) {
+    factory_ = factory;
+  }
+  iv::lv5::AstFactory* factory() const {
+    return factory_;
+  }
+  bool IsCaptureAnalyzed() const {
+    return analyzed_;
+  }
+  const Captures* captures() const {
+    return captures_;
+  }
+  void set_captures(const Captures* captures) const {
+    analyzed_ = true;
+    captures_ = captures;
+  }
+  std::size_t IncrementCallCount() const {
+    return ++call_count_;
+  }
+  const Plan* plan() const {
+    return plan_;
+  }
+  void set_plan(const Plan* plan) const {
+    plan_ = plan;
+  }
+ private:
+  iv::lv5::AstFactory* factory_;
+  mutable const Captures* captures_;
+  mutable const Plan* plan_;
+  mutable std::size_t call_count_;
+  mutable bool analyzed_;
 };
 
 template<>
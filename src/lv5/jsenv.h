@@ -138,6 +138,10 @@ class JSDeclEnv : public JSEnv {
     return record_;
   }
 
+  void Reserve(std::size_t n) {
+    record_.rehash(n);
+  }
+
   static JSDeclEnv* New(Context* ctx, JSEnv* outer) {
     return new JSDeclEnv(outer);
   }
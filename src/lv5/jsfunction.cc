@@ -14,7 +14,7 @@ namespace lv5 {
 
 void JSFunction::Initialize(Context* ctx) {
   // section 13.2 Creating Function Objects
-  const Class& cls = ctx->Cls("Function");
+  const Class& cls = ctx->Cls(ctx->Function_symbol());
   set_cls(cls.name);
   set_prototype(cls.prototype);
 
@@ -50,14 +50,65 @@ JSCodeFunction::JSCodeFunction(Context* ctx,
                                const FunctionLiteral* func,
                                JSScript* script,
                                JSEnv* env)
-  : function_(func),
+  : ctx_(ctx),
+    function_(func),
     script_(script),
-    env_(env) {
-  DefineOwnProperty(
-      ctx, ctx->length_symbol(),
-      DataDescriptor(func->params().size(),
-                     PropertyDescriptor::NONE),
+    env_(env),
+    poison_(ctx->IsStrict()),
+    materialized_(false) {
+  const Class& cls = ctx->Cls(ctx->Function_symbol());
+  set_cls(cls.name);
+  set_prototype(cls.prototype);
+}
+
+PropertyDescriptor JSCodeFunction::GetOwnProperty(Symbol name) const {
+  if (!materialized_ && IsLazyProperty(name)) {
+    MaterializeProperties();
+  }
+  return JSObject::GetOwnProperty(name);
+}
+
+bool JSCodeFunction::IsLazyProperty(Symbol name) const {
+  return name == ctx_->length_symbol() ||
+      name == ctx_->prototype_symbol() ||
+      (poison_ &&
+       (name == ctx_->caller_symbol() || name == ctx_->callee_symbol()));
+}
+
+void JSCodeFunction::MaterializeProperties() const {
+  if (materialized_) {
+    return;
+  }
+  materialized_ = true;
+  // these properties exist from creation of this function, so they are
+  // stored directly, even if this function is no longer extensible
+  JSCodeFunction* const self = const_cast<JSCodeFunction*>(this);
+  Context* const ctx = ctx_;
+  self->table_[ctx->length_symbol()] =
+      DataDescriptor(function_->params().size(),
+                     PropertyDescriptor::NONE).SetDefaultToAbsent();
+  JSObject* const proto = JSObject::New(ctx);
+  proto->DefineOwnProperty(
+      ctx, ctx->constructor_symbol(),
+      DataDescriptor(self,
+                     PropertyDescriptor::WRITABLE |
+                     PropertyDescriptor::CONFIGURABLE),
                      false, NULL);
+  self->table_[ctx->prototype_symbol()] =
+      DataDescriptor(proto,
+                     PropertyDescriptor::WRITABLE |
+                     PropertyDescriptor::CONFIGURABLE).SetDefaultToAbsent();
+  if (poison_) {
+    JSNativeFunction* const throw_type_error = ctx->throw_type_error();
+    self->table_[ctx->caller_symbol()] =
+        AccessorDescriptor(throw_type_error,
+                           throw_type_error,
+                           PropertyDescriptor::NONE).SetDefaultToAbsent();
+    self->table_[ctx->callee_symbol()] =
+        AccessorDescriptor(throw_type_error,
+                           throw_type_error,
+                           PropertyDescriptor::NONE).SetDefaultToAbsent();
+  }
 }
 
 JSVal JSCodeFunction::Call(
@@ -136,7 +187,7 @@ JSVal JSNativeFunction::Call(const Arguments& args,
 
 void JSNativeFunction::InitializeSimple(Context* ctx) {
   // section 13.2 Creating Function Objects
-  const Class& cls = ctx->Cls("Function");
+  const Class& cls = ctx->Cls(ctx->Function_symbol());
   set_cls(cls.name);
   set_prototype(cls.prototype);
 }
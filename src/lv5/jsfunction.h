@@ -54,12 +54,11 @@ class JSCodeFunction : public JSFunction {
                              const FunctionLiteral* func,
                              JSScript* script,
                              JSEnv* env) {
-    JSCodeFunction* const obj =
-        new JSCodeFunction(ctx, func, script, env);
-    obj->Initialize(ctx);
-    return obj;
+    return new JSCodeFunction(ctx, func, script, env);
   }
 
+  PropertyDescriptor GetOwnProperty(Symbol name) const;
+
   JSCodeFunction* AsCodeFunction() {
     return this;
   }
@@ -74,9 +73,19 @@ class JSCodeFunction : public JSFunction {
     return function_->strict();
   }
  private:
+  // section 13.2 Creating Function Objects
+  // length, prototype (and poisoned caller / callee in strict mode)
+  // are defined when they are first observed, because most functions
+  // are never used as constructors
+  bool IsLazyProperty(Symbol name) const;
+  void MaterializeProperties() const;
+
+  Context* ctx_;
   const FunctionLiteral* function_;
   JSScript* script_;
   JSEnv* env_;
+  bool poison_;
+  mutable bool materialized_;
 };
 
 class JSNativeFunction : public JSFunction {
@@ -269,6 +269,41 @@ bool JSObject::Delete(Symbol name, bool th, Error* res) {
   }
 }
 
+void JSObject::GetEnumerablePropertyNames(std::vector<Symbol>* names) const {
+  for (const JSObject* obj = this; obj; obj = obj->prototype()) {
+    const Properties& table = obj->table();
+    for (Properties::const_iterator it = table.begin(),
+         last = table.end(); it != last; ++it) {
+      if (!it->second.IsEnumerable()) {
+        continue;
+      }
+      bool shadowed = false;
+      for (const JSObject* near = this; near != obj; near = near->prototype()) {
+        if (near->table().count(it->first)) {
+          shadowed = true;
+          break;
+        }
+      }
+      if (!shadowed) {
+        names->push_back(it->first);
+      }
+    }
+  }
+}
+
+void JSObject::InitializeFromBoilerplate(const JSObject& boilerplate) {
+  prototype_ = boilerplate.prototype_;
+  cls_ = boilerplate.cls_;
+  extensible_ = true;
+  table_ = boilerplate.table_;
+}
+
+void JSObject::SetOwnDataValue(Symbol name, const JSVal& val) {
+  const Properties::iterator it = table_.find(name);
+  assert(it != table_.end() && it->second.IsDataDescriptor());
+  it->second.AsDataDescriptor()->set_value(val);
+}
+
 JSObject* JSObject::New(Context* ctx) {
   JSObject* const obj = NewPlain(ctx);
   const Symbol name = ctx->Intern("Object");
@@ -284,10 +319,14 @@ JSObject* JSObject::NewPlain(Context* ctx) {
 
 JSStringObject* JSStringObject::New(Context* ctx, JSString* str) {
   JSStringObject* const obj = new JSStringObject(str);
-  const Symbol name = ctx->Intern("String");
-  const Class& cls = ctx->Cls(name);
+  const Class& cls = ctx->Cls(ctx->String_symbol());
   obj->set_cls(cls.name);
   obj->set_prototype(cls.prototype);
+  // section 15.5.5.1 length
+  obj->DefineOwnProperty(ctx, ctx->length_symbol(),
+                         DataDescriptor(static_cast<double>(str->size()),
+                                        PropertyDescriptor::NONE),
+                         false, ctx->error());
   return obj;
 }
 
@@ -297,7 +336,7 @@ JSStringObject* JSStringObject::NewPlain(Context* ctx) {
 
 JSNumberObject* JSNumberObject::New(Context* ctx, const double& value) {
   JSNumberObject* const obj = new JSNumberObject(value);
-  const Class& cls = ctx->Cls("Number");
+  const Class& cls = ctx->Cls(ctx->Number_symbol());
   obj->set_cls(cls.name);
   obj->set_prototype(cls.prototype);
   return obj;
@@ -318,10 +357,56 @@ JSBooleanObject* JSBooleanObject::NewPlain(Context* ctx, bool value) {
 
 JSBooleanObject* JSBooleanObject::New(Context* ctx, bool value) {
   JSBooleanObject* const obj = new JSBooleanObject(value);
-  const Class& cls = ctx->Cls(ctx->Intern("Boolean"));
+  const Class& cls = ctx->Cls(ctx->Boolean_symbol());
   obj->set_cls(cls.name);
   obj->set_prototype(cls.prototype);
   return obj;
 }
 
+JSGlobal::JSGlobal()
+  : JSObject(),
+    cells_() {
+}
+
+bool JSGlobal::Delete(Symbol name, bool th, Error* res) {
+  const bool result = JSObject::Delete(name, th, res);
+  if (result) {
+    InvalidateCell(name);
+  }
+  return result;
+}
+
+bool JSGlobal::DefineOwnProperty(Context* ctx,
+                                 Symbol name,
+                                 const PropertyDescriptor& desc,
+                                 bool th,
+                                 Error* res) {
+  const bool result = JSObject::DefineOwnProperty(ctx, name, desc, th, res);
+  if (result && desc.IsAccessorDescriptor()) {
+    InvalidateCell(name);
+  }
+  return result;
+}
+
+PropertyCell* JSGlobal::LookupCell(Symbol name) {
+  // node of hash table is not moved until erased
+  const Properties::iterator it = table_.find(name);
+  if (it == table_.end() || !it->second.IsDataDescriptor()) {
+    return NULL;
+  }
+  PropertyCell*& cell = cells_[name];
+  if (!cell) {
+    cell = new PropertyCell();
+  }
+  cell->set_desc(&it->second);
+  return cell;
+}
+
+void JSGlobal::InvalidateCell(Symbol name) {
+  const Cells::iterator it = cells_.find(name);
+  if (it != cells_.end()) {
+    it->second->set_desc(NULL);
+  }
+}
+
 } }  // namespace iv::lv5
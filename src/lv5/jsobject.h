@@ -1,5 +1,6 @@
 #ifndef _IV_LV5_JSOBJECT_H_
 #define _IV_LV5_JSOBJECT_H_
+#include <vector>
 #include <gc/gc_cpp.h>
 #include "ast.h"
 #include "property.h"
@@ -82,13 +83,28 @@ class JSObject : public gc {
     cls_ = str;
   }
   const Properties& table() const {
+    MaterializeProperties();
     return table_;
   }
 
+  // enumerable property names of this object and its prototype chain,
+  // names shadowed by nearer objects are excluded
+  void GetEnumerablePropertyNames(std::vector<Symbol>* names) const;
+
+  // literal boilerplate support
+  // copies class, prototype and own properties of boilerplate directly
+  void InitializeFromBoilerplate(const JSObject& boilerplate);
+  // replaces value of own data property defined by boilerplate
+  void SetOwnDataValue(Symbol name, const JSVal& val);
+
   static JSObject* New(Context* ctx);
   static JSObject* NewPlain(Context* ctx);
 
  protected:
+  // objects defining own properties lazily materialize them here
+  // before the whole property table is observed
+  virtual void MaterializeProperties() const { }
+
   JSObject* prototype_;
   JSString* cls_;
   bool extensible_;
@@ -140,5 +156,43 @@ class JSBooleanObject : public JSObject {
   bool value_;
 };
 
+// stable location of own data property of global object.
+// identifier sites cache cells and access global variables
+// without scope chain walk and property table lookup.
+class PropertyCell : public gc {
+ public:
+  PropertyCell() : desc_(NULL) { }
+  // NULL after the property is deleted or redefined as accessor
+  PropertyDescriptor* desc() const {
+    return desc_;
+  }
+  void set_desc(PropertyDescriptor* desc) {
+    desc_ = desc;
+  }
+ private:
+  PropertyDescriptor* desc_;
+};
+
+class JSGlobal : public JSObject {
+ public:
+  typedef GCHashMap<Symbol, PropertyCell*>::type Cells;
+
+  JSGlobal();
+  bool Delete(Symbol name, bool th, Error* res);
+  bool DefineOwnProperty(Context* ctx,
+                         Symbol name,
+                         const PropertyDescriptor& desc,
+                         bool th,
+                         Error* res);
+  // returns cell of own data property, or NULL if not exists.
+  // one cell is created per name and reused after revalidation
+  PropertyCell* LookupCell(Symbol name);
+
+ private:
+  void InvalidateCell(Symbol name);
+
+  Cells cells_;
+};
+
 } }  // namespace iv::lv5
 #endif  // _IV_LV5_JSOBJECT_H_
@@ -0,0 +1,677 @@
+#ifndef _IV_LV5_JSON_H_
+#define _IV_LV5_JSON_H_
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <tr1/array>
+#include "none.h"
+#include "chars.h"
+#include "conversions.h"
+#include "dtoa.h"
+#include "ustring.h"
+#include "ustringpiece.h"
+#include "noncopyable.h"
+#include "jsval.h"
+#include "jsstring.h"
+#include "jsobject.h"
+#include "jsarray.h"
+#include "jsfunction.h"
+#include "arguments.h"
+#include "property.h"
+#include "class.h"
+#include "context.h"
+#include "error.h"
+namespace iv {
+namespace lv5 {
+namespace detail {
+
+// escape table of JSON strings for ASCII range
+// 0 means plain character, otherwise escape character after backslash.
+// same characters are special in JSON text of string,
+// so both scanning and quoting skip runs of plain characters at once.
+template<typename T>
+class JSONEscapeData {
+ public:
+  static const char kEscapeTable[128];
+};
+
+template<typename T>
+const char JSONEscapeData<T>::kEscapeTable[128] = {
+  'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+  'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+  'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+  'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+  0, 0, '"', 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, '\\', 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0
+};
+
+typedef JSONEscapeData<core::None> JSONEscape;
+
+inline bool IsJSONPlain(uc16 c) {
+  return c >= 128 || !JSONEscape::kEscapeTable[c];
+}
+
+inline void GetOwnEnumerablePropertyNames(const JSObject* obj,
+                                          std::vector<Symbol>* names) {
+  for (JSObject::Properties::const_iterator it = obj->table().begin(),
+       last = obj->table().end(); it != last; ++it) {
+    if (it->second.IsEnumerable()) {
+      names->push_back(it->first);
+    }
+  }
+}
+
+}  // namespace iv::lv5::detail
+
+// section 15.12.2 JSON.parse (text)
+// objects and arrays are built directly,
+// not through ObjectLiteral / ArrayLiteral evaluation
+class JSONParser : private core::Noncopyable<JSONParser>::type {
+ public:
+  static const std::size_t kMaxDepth = 4096;
+
+  JSONParser(Context* ctx, const core::UStringPiece& source)
+    : ctx_(ctx),
+      pos_(source.data()),
+      end_(source.data() + source.size()),
+      depth_(0),
+      object_cls_(ctx->Cls("Object")),
+      buffer_() {
+  }
+
+  JSVal Parse(Error* error) {
+    const JSVal result = ParseValue(error);
+    if (*error) {
+      return JSUndefined;
+    }
+    SkipWhitespace();
+    if (pos_ != end_) {
+      return Unexpected(error);
+    }
+    return result;
+  }
+
+ private:
+  JSVal ParseValue(Error* error) {
+    SkipWhitespace();
+    if (pos_ == end_) {
+      return Unexpected(error);
+    }
+    switch (*pos_) {
+      case '{':
+        return ParseObject(error);
+      case '[':
+        return ParseArray(error);
+      case '"': {
+        core::UStringPiece str;
+        if (!ScanString(&str, error)) {
+          return JSUndefined;
+        }
+        return JSString::New(ctx_, str);
+      }
+      case 't':
+        return ParseLiteral("true", JSTrue, error);
+      case 'f':
+        return ParseLiteral("false", JSFalse, error);
+      case 'n':
+        return ParseLiteral("null", JSNull, error);
+      default:
+        if (*pos_ == '-' || core::Chars::IsDecimalDigit(*pos_)) {
+          return ParseNumber(error);
+        }
+        return Unexpected(error);
+    }
+  }
+
+  JSVal ParseObject(Error* error) {
+    if (!Enter(error)) {
+      return JSUndefined;
+    }
+    ++pos_;
+    JSObject* const obj = JSObject::NewPlain(ctx_);
+    obj->set_cls(object_cls_.name);
+    obj->set_prototype(object_cls_.prototype);
+    SkipWhitespace();
+    if (pos_ != end_ && *pos_ == '}') {
+      ++pos_;
+      --depth_;
+      return obj;
+    }
+    while (true) {
+      SkipWhitespace();
+      if (pos_ == end_ || *pos_ != '"') {
+        return Unexpected(error);
+      }
+      core::UStringPiece str;
+      if (!ScanString(&str, error)) {
+        return JSUndefined;
+      }
+      const Symbol key = ctx_->Intern(str);
+      SkipWhitespace();
+      if (pos_ == end_ || *pos_ != ':') {
+        return Unexpected(error);
+      }
+      ++pos_;
+      const JSVal value = ParseValue(error);
+      if (*error) {
+        return JSUndefined;
+      }
+      obj->DefineOwnProperty(ctx_, key,
+                             DataDescriptor(value,
+                                            PropertyDescriptor::WRITABLE |
+                                            PropertyDescriptor::ENUMERABLE |
+                                            PropertyDescriptor::CONFIGURABLE),
+                             false, error);
+      if (*error) {
+        return JSUndefined;
+      }
+      SkipWhitespace();
+      if (pos_ != end_ && *pos_ == ',') {
+        ++pos_;
+      } else if (pos_ != end_ && *pos_ == '}') {
+        ++pos_;
+        --depth_;
+        return obj;
+      } else {
+        return Unexpected(error);
+      }
+    }
+  }
+
+  JSVal ParseArray(Error* error) {
+    if (!Enter(error)) {
+      return JSUndefined;
+    }
+    ++pos_;
+    JSArray::Vector values;
+    SkipWhitespace();
+    if (pos_ != end_ && *pos_ == ']') {
+      ++pos_;
+      --depth_;
+      return JSArray::New(ctx_, values);
+    }
+    while (true) {
+      const JSVal value = ParseValue(error);
+      if (*error) {
+        return JSUndefined;
+      }
+      values.push_back(value);
+      SkipWhitespace();
+      if (pos_ != end_ && *pos_ == ',') {
+        ++pos_;
+      } else if (pos_ != end_ && *pos_ == ']') {
+        ++pos_;
+        --depth_;
+        return JSArray::New(ctx_, values);
+      } else {
+        return Unexpected(error);
+      }
+    }
+  }
+
+  // string without escape refers source directly,
+  // otherwise decoded to buffer, which is valid until next scan
+  bool ScanString(core::UStringPiece* str, Error* error) {
+    ++pos_;
+    const uc16* run = pos_;
+    SkipPlain();
+    if (pos_ != end_ && *pos_ == '"') {
+      *str = core::UStringPiece(run, pos_ - run);
+      ++pos_;
+      return true;
+    }
+    buffer_.assign(run, pos_);
+    while (pos_ != end_) {
+      if (*pos_ == '"') {
+        ++pos_;
+        *str = core::UStringPiece(buffer_.data(), buffer_.size());
+        return true;
+      }
+      if (*pos_ != '\\' || ++pos_ == end_) {
+        // control character or unterminated escape
+        break;
+      }
+      switch (*pos_++) {
+        case '"':
+          buffer_.push_back('"');
+          break;
+        case '\\':
+          buffer_.push_back('\\');
+          break;
+        case '/':
+          buffer_.push_back('/');
+          break;
+        case 'b':
+          buffer_.push_back('\b');
+          break;
+        case 'f':
+          buffer_.push_back('\f');
+          break;
+        case 'n':
+          buffer_.push_back('\n');
+          break;
+        case 'r':
+          buffer_.push_back('\r');
+          break;
+        case 't':
+          buffer_.push_back('\t');
+          break;
+        case 'u': {
+          uc16 code = 0;
+          for (int i = 0; i < 4; ++i, ++pos_) {
+            if (pos_ == end_ || !core::Chars::IsHexDigit(*pos_)) {
+              Unexpected(error);
+              return false;
+            }
+            code = code * 16 + HexValue(*pos_);
+          }
+          buffer_.push_back(code);
+          break;
+        }
+        default:
+          --pos_;
+          Unexpected(error);
+          return false;
+      }
+      run = pos_;
+      SkipPlain();
+      buffer_.append(run, pos_);
+    }
+    Unexpected(error);
+    return false;
+  }
+
+  JSVal ParseNumber(Error* error) {
+    const uc16* const start = pos_;
+    const bool negative = (*pos_ == '-');
+    if (negative) {
+      ++pos_;
+    }
+    if (pos_ != end_ && *pos_ == '0') {
+      ++pos_;
+    } else if (!SkipDigits()) {
+      return Unexpected(error);
+    }
+    bool integral = true;
+    if (pos_ != end_ && *pos_ == '.') {
+      integral = false;
+      ++pos_;
+      if (!SkipDigits()) {
+        return Unexpected(error);
+      }
+    }
+    if (pos_ != end_ && (*pos_ == 'e' || *pos_ == 'E')) {
+      integral = false;
+      ++pos_;
+      if (pos_ != end_ && (*pos_ == '+' || *pos_ == '-')) {
+        ++pos_;
+      }
+      if (!SkipDigits()) {
+        return Unexpected(error);
+      }
+    }
+    const std::size_t len = pos_ - start;
+    if (integral && len < 10) {
+      // small integer, no precision problem
+      int32_t value = 0;
+      for (const uc16* it = negative ? start + 1 : start; it != pos_; ++it) {
+        value = value * 10 + (*it - '0');
+      }
+      const double number = value;
+      return negative ? -number : number;
+    }
+    return core::StringToDouble(core::UStringPiece(start, len), false);
+  }
+
+  JSVal ParseLiteral(const char* literal, const JSVal& value, Error* error) {
+    for (; *literal; ++literal, ++pos_) {
+      if (pos_ == end_ || *pos_ != *literal) {
+        return Unexpected(error);
+      }
+    }
+    return value;
+  }
+
+  bool Enter(Error* error) {
+    if (++depth_ > kMaxDepth) {
+      error->Report(Error::Range, "JSON.parse: nesting too deep");
+      return false;
+    }
+    return true;
+  }
+
+  JSVal Unexpected(Error* error) {
+    if (pos_ == end_) {
+      error->Report(Error::Syntax, "JSON.parse: unexpected end of input");
+    } else {
+      error->Report(Error::Syntax, "JSON.parse: unexpected character");
+    }
+    return JSUndefined;
+  }
+
+  inline void SkipWhitespace() {
+    while (pos_ != end_ &&
+           (*pos_ == ' ' || *pos_ == '\n' || *pos_ == '\r' || *pos_ == '\t')) {
+      ++pos_;
+    }
+  }
+
+  inline void SkipPlain() {
+    while (pos_ != end_ && detail::IsJSONPlain(*pos_)) {
+      ++pos_;
+    }
+  }
+
+  inline bool SkipDigits() {
+    const uc16* const start = pos_;
+    while (pos_ != end_ && core::Chars::IsDecimalDigit(*pos_)) {
+      ++pos_;
+    }
+    return pos_ != start;
+  }
+
+  static int HexValue(uc16 c) {
+    if (c <= '9') {
+      return c - '0';
+    }
+    return (c | 0x20) - 'a' + 10;
+  }
+
+  Context* ctx_;
+  const uc16* pos_;
+  const uc16* end_;
+  std::size_t depth_;
+  const Class object_cls_;
+  core::UString buffer_;
+};
+
+// section 15.12.3 JSON.stringify (value [, replacer [, space ]])
+// output is written to one buffer while walking values,
+// so no intermediate string is created for members
+class JSONStringifier : private core::Noncopyable<JSONStringifier>::type {
+ public:
+  JSONStringifier(Context* ctx,
+                  JSFunction* replacer,
+                  const std::vector<Symbol>* property_list,
+                  const core::UString& gap)
+    : ctx_(ctx),
+      replacer_(replacer),
+      property_list_(property_list),
+      gap_(gap),
+      indent_(),
+      stack_(),
+      out_(),
+      array_cls_(ctx->Cls(ctx->Array_symbol()).name),
+      toJSON_symbol_(ctx->Intern("toJSON")) {
+  }
+
+  // returns NULL if result is undefined
+  JSString* Stringify(const JSVal& value, Error* error) {
+    JSObject* const wrapper = JSObject::New(ctx_);
+    const Symbol empty = ctx_->Intern("");
+    wrapper->DefineOwnProperty(ctx_, empty,
+                               DataDescriptor(value,
+                                              PropertyDescriptor::WRITABLE |
+                                              PropertyDescriptor::ENUMERABLE |
+                                              PropertyDescriptor::CONFIGURABLE),
+                               false, error);
+    if (*error) {
+      return NULL;
+    }
+    const JSVal val = Prepare(empty, wrapper, value, error);
+    if (*error || !IsSerializable(val)) {
+      return NULL;
+    }
+    Write(val, error);
+    if (*error) {
+      return NULL;
+    }
+    return JSString::New(ctx_, core::UStringPiece(out_.data(), out_.size()));
+  }
+
+ private:
+  // Str steps 1 - 4,
+  // value after toJSON, replacer and unwrapping primitive objects
+  JSVal Prepare(Symbol key, JSObject* holder, JSVal value, Error* error) {
+    if (value.IsObject()) {
+      const JSVal to_json = value.object()->Get(ctx_, toJSON_symbol_, error);
+      if (*error) {
+        return JSUndefined;
+      }
+      if (to_json.IsCallable()) {
+        Arguments args(ctx_, 1);
+        args.set_this_binding(value);
+        args[0] = ctx_->ToString(key);
+        value = to_json.object()->AsCallable()->Call(args, error);
+        if (*error) {
+          return JSUndefined;
+        }
+      }
+    }
+    if (replacer_) {
+      Arguments args(ctx_, 2);
+      args.set_this_binding(holder);
+      args[0] = ctx_->ToString(key);
+      args[1] = value;
+      value = replacer_->Call(args, error);
+      if (*error) {
+        return JSUndefined;
+      }
+    }
+    if (value.IsObject()) {
+      JSObject* const obj = value.object();
+      if (obj->AsNumberObject()) {
+        return value.ToNumber(ctx_, error);
+      } else if (obj->AsStringObject()) {
+        return value.ToString(ctx_, error);
+      } else if (JSBooleanObject* const boolean = obj->AsBooleanObject()) {
+        return JSVal::Bool(boolean->value());
+      }
+    }
+    return value;
+  }
+
+  static bool IsSerializable(const JSVal& value) {
+    return !value.IsUndefined() && !value.IsCallable();
+  }
+
+  // Str steps 5 - 11, value must be serializable
+  void Write(const JSVal& value, Error* error) {
+    if (value.IsNull()) {
+      Append("null");
+    } else if (value.IsBoolean()) {
+      Append(value.boolean() ? "true" : "false");
+    } else if (value.IsString()) {
+      Quote(value.string()->ToPiece());
+    } else if (value.IsNumber()) {
+      const double number = value.number();
+      if (std::isfinite(number)) {
+        std::tr1::array<char, 80> buffer;
+        Append(core::DoubleToCString(number, buffer.data(), buffer.size()));
+      } else {
+        Append("null");
+      }
+    } else {
+      assert(value.IsObject());
+      JSObject* const obj = value.object();
+      if (obj->cls() == array_cls_) {
+        WriteArray(obj, error);
+      } else {
+        WriteObject(obj, error);
+      }
+    }
+  }
+
+  // section 15.12.3 JO
+  void WriteObject(JSObject* obj, Error* error) {
+    if (!Enter(obj, error)) {
+      return;
+    }
+    const std::size_t stepback = indent_.size();
+    indent_.append(gap_);
+    std::vector<Symbol> keys;
+    if (property_list_) {
+      keys = *property_list_;
+    } else {
+      detail::GetOwnEnumerablePropertyNames(obj, &keys);
+    }
+    out_.push_back('{');
+    bool empty = true;
+    for (std::vector<Symbol>::const_iterator it = keys.begin(),
+         last = keys.end(); it != last; ++it) {
+      JSVal value = obj->Get(ctx_, *it, error);
+      if (*error) {
+        return;
+      }
+      value = Prepare(*it, obj, value, error);
+      if (*error) {
+        return;
+      }
+      if (!IsSerializable(value)) {
+        continue;
+      }
+      if (!empty) {
+        out_.push_back(',');
+      }
+      empty = false;
+      NewLine();
+      Quote(ctx_->GetContent(*it));
+      out_.push_back(':');
+      if (!gap_.empty()) {
+        out_.push_back(' ');
+      }
+      Write(value, error);
+      if (*error) {
+        return;
+      }
+    }
+    indent_.resize(stepback);
+    if (!empty) {
+      NewLine();
+    }
+    out_.push_back('}');
+    stack_.pop_back();
+  }
+
+  // section 15.12.3 JA
+  void WriteArray(JSObject* ary, Error* error) {
+    if (!Enter(ary, error)) {
+      return;
+    }
+    const std::size_t stepback = indent_.size();
+    indent_.append(gap_);
+    const JSVal length = ary->Get(ctx_, ctx_->length_symbol(), error);
+    if (*error) {
+      return;
+    }
+    const uint32_t len =
+        core::DoubleToUInt32(length.ToNumber(ctx_, error));
+    if (*error) {
+      return;
+    }
+    out_.push_back('[');
+    for (uint32_t index = 0; index < len; ++index) {
+      if (index) {
+        out_.push_back(',');
+      }
+      NewLine();
+      const Symbol key = ctx_->InternIndex(index);
+      JSVal value = ary->Get(ctx_, key, error);
+      if (*error) {
+        return;
+      }
+      value = Prepare(key, ary, value, error);
+      if (*error) {
+        return;
+      }
+      if (IsSerializable(value)) {
+        Write(value, error);
+        if (*error) {
+          return;
+        }
+      } else {
+        Append("null");
+      }
+    }
+    indent_.resize(stepback);
+    if (len) {
+      NewLine();
+    }
+    out_.push_back(']');
+    stack_.pop_back();
+  }
+
+  // section 15.12.3 Quote
+  void Quote(const core::UStringPiece& str) {
+    static const char* const kHexDigits = "0123456789abcdef";
+    out_.push_back('"');
+    const uc16* run = str.data();
+    const uc16* const last = str.data() + str.size();
+    for (const uc16* it = run; it != last; ++it) {
+      if (detail::IsJSONPlain(*it)) {
+        continue;
+      }
+      out_.append(run, it);
+      run = it + 1;
+      const char escape = detail::JSONEscape::kEscapeTable[*it];
+      out_.push_back('\\');
+      out_.push_back(escape);
+      if (escape == 'u') {
+        out_.push_back('0');
+        out_.push_back('0');
+        out_.push_back(kHexDigits[*it >> 4]);
+        out_.push_back(kHexDigits[*it & 0xF]);
+      }
+    }
+    out_.append(run, last);
+    out_.push_back('"');
+  }
+
+  bool Enter(JSObject* obj, Error* error) {
+    if (std::find(stack_.begin(), stack_.end(), obj) != stack_.end()) {
+      error->Report(Error::Type, "JSON.stringify: cyclic structure");
+      return false;
+    }
+    if (stack_.size() >= JSONParser::kMaxDepth) {
+      error->Report(Error::Range, "JSON.stringify: nesting too deep");
+      return false;
+    }
+    stack_.push_back(obj);
+    return true;
+  }
+
+  inline void NewLine() {
+    if (!gap_.empty()) {
+      out_.push_back('\n');
+      out_.append(indent_);
+    }
+  }
+
+  inline void Append(const char* str) {
+    out_.append(str, str + std::strlen(str));
+  }
+
+  Context* ctx_;
+  JSFunction* replacer_;
+  const std::vector<Symbol>* property_list_;
+  const core::UString gap_;
+  core::UString indent_;
+  std::vector<JSObject*> stack_;
+  core::UString out_;
+  JSString* array_cls_;
+  Symbol toJSON_symbol_;
+};
+
+} }  // namespace iv::lv5
+#endif  // _IV_LV5_JSON_H_
@@ -6,12 +6,16 @@
 namespace iv {
 namespace lv5 {
 
+class PropertyCell;
+
 class JSReference : public gc {
  public:
-  JSReference(JSVal base, Symbol name, bool is_strict)
+  JSReference(JSVal base, Symbol name, bool is_strict,
+              PropertyCell* cell)
     : base_(base),
       name_(name),
-      is_strict_(is_strict) {
+      is_strict_(is_strict),
+      cell_(cell) {
   }
   bool IsStrictReference() const {
     return is_strict_;
@@ -39,15 +43,23 @@ class JSReference : public gc {
   inline const JSVal* base() const {
     return &base_;
   }
+
+  // property cell of global binding, if resolved through it
+  PropertyCell* cell() const {
+    return cell_;
+  }
+
   static JSReference* New(Context* ctx,
-                          JSVal base, Symbol name, bool is_strict) {
-    return new JSReference(base, name, is_strict);
+                          JSVal base, Symbol name, bool is_strict,
+                          PropertyCell* cell = NULL) {
+    return new JSReference(base, name, is_strict, cell);
   }
 
  private:
   JSVal base_;
   Symbol name_;
   bool is_strict_;
+  PropertyCell* cell_;
 };
 } }  // namespace iv::lv5
 #endif  // _IV_LV5_JSREFERENCE_H_
@@ -0,0 +1,302 @@
+#ifndef _IV_LV5_JSTYPED_FUNCTION_H_
+#define _IV_LV5_JSTYPED_FUNCTION_H_
+#include <tr1/cstdint>
+#include "conversions.h"
+#include "jsval.h"
+#include "jsstring.h"
+#include "jsobject.h"
+#include "jsfunction.h"
+#include "arguments.h"
+#include "error.h"
+#include "lv5.h"
+namespace iv {
+namespace lv5 {
+namespace detail {
+
+// conversion from argument value to typed C++ parameter.
+// Context* and Error* parameters receive the caller's context and error,
+// and do not consume an argument.
+template<typename T>
+struct TypedArgument;
+
+inline JSVal ArgumentAt(const Arguments& args, std::size_t n) {
+  return (n < args.size()) ? args[n] : JSVal(JSUndefined);
+}
+
+template<>
+struct TypedArgument<double> {
+  static const std::size_t kSize = 1;
+  static double Extract(const Arguments& args,
+                        std::size_t n, Error* error) {
+    return ArgumentAt(args, n).ToNumber(args.ctx(), error);
+  }
+};
+
+template<>
+struct TypedArgument<int32_t> {
+  static const std::size_t kSize = 1;
+  static int32_t Extract(const Arguments& args,
+                         std::size_t n, Error* error) {
+    return core::DoubleToInt32(
+        ArgumentAt(args, n).ToNumber(args.ctx(), error));
+  }
+};
+
+template<>
+struct TypedArgument<bool> {
+  static const std::size_t kSize = 1;
+  static bool Extract(const Arguments& args,
+                      std::size_t n, Error* error) {
+    return ArgumentAt(args, n).ToBoolean(error);
+  }
+};
+
+template<>
+struct TypedArgument<JSString*> {
+  static const std::size_t kSize = 1;
+  static JSString* Extract(const Arguments& args,
+                           std::size_t n, Error* error) {
+    return ArgumentAt(args, n).ToString(args.ctx(), error);
+  }
+};
+
+template<>
+struct TypedArgument<JSObject*> {
+  static const std::size_t kSize = 1;
+  static JSObject* Extract(const Arguments& args,
+                           std::size_t n, Error* error) {
+    return ArgumentAt(args, n).ToObject(args.ctx(), error);
+  }
+};
+
+template<>
+struct TypedArgument<JSVal> {
+  static const std::size_t kSize = 1;
+  static JSVal Extract(const Arguments& args,
+                       std::size_t n, Error* error) {
+    return ArgumentAt(args, n);
+  }
+};
+
+template<>
+struct TypedArgument<Context*> {
+  static const std::size_t kSize = 0;
+  static Context* Extract(const Arguments& args,
+                          std::size_t n, Error* error) {
+    return args.ctx();
+  }
+};
+
+template<>
+struct TypedArgument<Error*> {
+  static const std::size_t kSize = 0;
+  static Error* Extract(const Arguments& args,
+                        std::size_t n, Error* error) {
+    return error;
+  }
+};
+
+// calls typed function and converts result to JSVal
+template<typename R>
+struct TypedCall {
+  static JSVal Result(const R& res) {
+    return res;
+  }
+  template<typename F>
+  static JSVal Call(F f) {
+    return Result(f());
+  }
+  template<typename F, typename A1>
+  static JSVal Call(F f, A1 a1) {
+    return Result(f(a1));
+  }
+  template<typename F, typename A1, typename A2>
+  static JSVal Call(F f, A1 a1, A2 a2) {
+    return Result(f(a1, a2));
+  }
+  template<typename F, typename A1, typename A2, typename A3>
+  static JSVal Call(F f, A1 a1, A2 a2, A3 a3) {
+    return Result(f(a1, a2, a3));
+  }
+};
+
+template<>
+inline JSVal TypedCall<int32_t>::Result(const int32_t& res) {
+  return static_cast<double>(res);
+}
+
+// bool is not convertible to JSVal implicitly
+template<>
+inline JSVal TypedCall<bool>::Result(const bool& res) {
+  return JSVal::Bool(res);
+}
+
+template<>
+struct TypedCall<void> {
+  template<typename F>
+  static JSVal Call(F f) {
+    f();
+    return JSUndefined;
+  }
+  template<typename F, typename A1>
+  static JSVal Call(F f, A1 a1) {
+    f(a1);
+    return JSUndefined;
+  }
+  template<typename F, typename A1, typename A2>
+  static JSVal Call(F f, A1 a1, A2 a2) {
+    f(a1, a2);
+    return JSUndefined;
+  }
+  template<typename F, typename A1, typename A2, typename A3>
+  static JSVal Call(F f, A1 a1, A2 a2, A3 a3) {
+    f(a1, a2, a3);
+    return JSUndefined;
+  }
+};
+
+}  // namespace iv::lv5::detail
+
+// native function declared with typed C++ parameters
+// (double, int32_t, bool, JSString*, JSObject*, JSVal, Context*, Error*)
+// conversion glue is generated per signature at compile time,
+// and each arity reads argument values directly from the VM stack.
+// length property is the number of arguments consumed.
+template<typename Signature>
+class JSTypedFunction;
+
+template<typename R>
+class JSTypedFunction<R(*)()> : public JSNativeFunction {
+ public:
+  typedef R(*function_type)();
+  static const std::size_t kArity = 0;
+
+  JSTypedFunction(Context* ctx, function_type func)
+    : JSNativeFunction(ctx, NULL, kArity),
+      typed_(func) {
+  }
+
+  JSVal Call(const Arguments& args, Error* error) {
+    CONSTRUCTOR_CHECK("function", args, error);
+    const JSVal res = detail::TypedCall<R>::Call(typed_);
+    if (*error) {
+      return JSUndefined;
+    }
+    return res;
+  }
+
+  static JSTypedFunction* New(Context* ctx, function_type func) {
+    JSTypedFunction* const obj = new JSTypedFunction(ctx, func);
+    obj->InitializeSimple(ctx);
+    return obj;
+  }
+
+ private:
+  function_type typed_;
+};
+
+template<typename R, typename A1>
+class JSTypedFunction<R(*)(A1)> : public JSNativeFunction {
+ public:
+  typedef R(*function_type)(A1);
+  typedef detail::TypedArgument<A1> Arg1;
+  static const std::size_t kArity = Arg1::kSize;
+
+  JSTypedFunction(Context* ctx, function_type func)
+    : JSNativeFunction(ctx, NULL, kArity),
+      typed_(func) {
+  }
+
+  JSVal Call(const Arguments& args, Error* error) {
+    CONSTRUCTOR_CHECK("function", args, error);
+    const A1 a1 = Arg1::Extract(args, 0, ERROR(error));
+    const JSVal res = detail::TypedCall<R>::Call(typed_, a1);
+    if (*error) {
+      return JSUndefined;
+    }
+    return res;
+  }
+
+  static JSTypedFunction* New(Context* ctx, function_type func) {
+    JSTypedFunction* const obj = new JSTypedFunction(ctx, func);
+    obj->InitializeSimple(ctx);
+    return obj;
+  }
+
+ private:
+  function_type typed_;
+};
+
+template<typename R, typename A1, typename A2>
+class JSTypedFunction<R(*)(A1, A2)> : public JSNativeFunction {
+ public:
+  typedef R(*function_type)(A1, A2);
+  typedef detail::TypedArgument<A1> Arg1;
+  typedef detail::TypedArgument<A2> Arg2;
+  static const std::size_t kArity = Arg1::kSize + Arg2::kSize;
+
+  JSTypedFunction(Context* ctx, function_type func)
+    : JSNativeFunction(ctx, NULL, kArity),
+      typed_(func) {
+  }
+
+  JSVal Call(const Arguments& args, Error* error) {
+    CONSTRUCTOR_CHECK("function", args, error);
+    const A1 a1 = Arg1::Extract(args, 0, ERROR(error));
+    const A2 a2 = Arg2::Extract(args, Arg1::kSize, ERROR(error));
+    const JSVal res = detail::TypedCall<R>::Call(typed_, a1, a2);
+    if (*error) {
+      return JSUndefined;
+    }
+    return res;
+  }
+
+  static JSTypedFunction* New(Context* ctx, function_type func) {
+    JSTypedFunction* const obj = new JSTypedFunction(ctx, func);
+    obj->InitializeSimple(ctx);
+    return obj;
+  }
+
+ private:
+  function_type typed_;
+};
+
+template<typename R, typename A1, typename A2, typename A3>
+class JSTypedFunction<R(*)(A1, A2, A3)> : public JSNativeFunction {
+ public:
+  typedef R(*function_type)(A1, A2, A3);
+  typedef detail::TypedArgument<A1> Arg1;
+  typedef detail::TypedArgument<A2> Arg2;
+  typedef detail::TypedArgument<A3> Arg3;
+  static const std::size_t kArity = Arg1::kSize + Arg2::kSize + Arg3::kSize;
+
+  JSTypedFunction(Context* ctx, function_type func)
+    : JSNativeFunction(ctx, NULL, kArity),
+      typed_(func) {
+  }
+
+  JSVal Call(const Arguments& args, Error* error) {
+    CONSTRUCTOR_CHECK("function", args, error);
+    const A1 a1 = Arg1::Extract(args, 0, ERROR(error));
+    const A2 a2 = Arg2::Extract(args, Arg1::kSize, ERROR(error));
+    const A3 a3 = Arg3::Extract(args,
+                                Arg1::kSize + Arg2::kSize, ERROR(error));
+    const JSVal res = detail::TypedCall<R>::Call(typed_, a1, a2, a3);
+    if (*error) {
+      return JSUndefined;
+    }
+    return res;
+  }
+
+  static JSTypedFunction* New(Context* ctx, function_type func) {
+    JSTypedFunction* const obj = new JSTypedFunction(ctx, func);
+    obj->InitializeSimple(ctx);
+    return obj;
+  }
+
+ private:
+  function_type typed_;
+};
+
+} }  // namespace iv::lv5
+#endif  // _IV_LV5_JSTYPED_FUNCTION_H_
@@ -518,5 +518,35 @@ inline bool SameValue(const JSVal& lhs, const JSVal& rhs) {
   return false;
 }
 
+inline bool StrictEqual(const JSVal& lhs, const JSVal& rhs) {
+  if (lhs.type() != rhs.type()) {
+    return false;
+  }
+  if (lhs.IsUndefined()) {
+    return true;
+  }
+  if (lhs.IsNull()) {
+    return true;
+  }
+  if (lhs.IsNumber()) {
+    const double& lhsv = lhs.number();
+    const double& rhsv = rhs.number();
+    if (std::isnan(lhsv) || std::isnan(rhsv)) {
+      return false;
+    }
+    return lhsv == rhsv;
+  }
+  if (lhs.IsString()) {
+    return *(lhs.string()) == *(rhs.string());
+  }
+  if (lhs.IsBoolean()) {
+    return lhs.boolean() == rhs.boolean();
+  }
+  if (lhs.IsObject()) {
+    return lhs.object() == rhs.object();
+  }
+  return false;
+}
+
 } }  // namespace iv::lv5
 #endif  // _IV_LV5_JSVAL_H_
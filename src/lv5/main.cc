@@ -16,6 +16,7 @@
 #include "ast.h"
 
 #include "ast_serializer.h"
+#include "ast_optimizer.h"
 
 #include "parser.h"
 #include "factory.h"
@@ -54,6 +55,21 @@ int main(int argc, char **argv) {
   cmd.Add("ast",
           "ast",
           0, "print ast");
+  cmd.Add("no-optimize",
+          "no-optimize",
+          0, "disable constant folding and dead code elimination");
+  cmd.Add("loop-profile",
+          "loop-profile",
+          0, "print iteration statistics of loops");
+  cmd.Add("max-call-depth",
+          "max-call-depth",
+          0, "limit depth of function calls", false,
+          static_cast<int>(iv::lv5::FrameStack::kDefaultMaxDepth),
+          iv::cmdline::range(1, 1 << 20));
+  cmd.Add("time-limit",
+          "time-limit",
+          0, "stop script after the given CPU time in milliseconds", false, 0,
+          iv::cmdline::range(0, 1 << 30));
   cmd.Add("copyright",
           "copyright",
           0,   "print the copyright");
@@ -105,22 +121,36 @@ int main(int argc, char **argv) {
     iv::lv5::AstFactory factory(&ctx);
     iv::core::Parser<iv::lv5::AstFactory, iv::icu::Source>
         parser(&factory, &src);
-    const iv::lv5::FunctionLiteral* const global = parser.ParseProgram();
+    iv::lv5::FunctionLiteral* const global = parser.ParseProgram();
 
     if (!global) {
       std::cerr << parser.error() << std::endl;
       return EXIT_FAILURE;
     }
 
+    if (!cmd.Exist("no-optimize")) {
+      iv::core::ast::AstOptimizer<iv::lv5::AstFactory> optimizer(&factory);
+      optimizer.Optimize(global);
+    }
+
     if (cmd.Exist("ast")) {
       iv::core::ast::AstSerializer<iv::lv5::AstFactory> ser;
       global->Accept(&ser);
       std::cout << ser.out() << std::endl;
     } else {
       ctx.DefineFunction(&iv::lv5::Print, "print", 1);
+      ctx.frames()->set_max_depth(cmd.get<int>("max-call-depth"));
+      ctx.budget()->set_time_limit(cmd.get<int>("time-limit"));
+      ctx.budget()->Start();
+      const bool loop_profile = cmd.Exist("loop-profile");
+      ctx.interp()->set_loop_profile(loop_profile);
       iv::lv5::JSScript* const script = iv::lv5::JSGlobalScript::New(
           &ctx, global, &factory, &src);
-      if (ctx.Run(script)) {
+      const bool failed = ctx.Run(script);
+      if (loop_profile) {
+        ctx.interp()->DumpLoopProfile(&std::cerr);
+      }
+      if (failed) {
         const JSVal e = ctx.ErrorVal();
         ctx.error()->Clear();
         const iv::lv5::JSString* const str = e.ToString(&ctx, ctx.error());
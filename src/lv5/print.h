@@ -8,7 +8,7 @@ namespace iv {
 namespace lv5 {
 
 inline JSVal Print(const Arguments& args, Error* error) {
-  if (args.args().size() > 0) {
+  if (!args.empty()) {
     const std::size_t last_index = args.size() - 1;
     std::size_t index = 0;
     for (Arguments::const_iterator it = args.begin(),
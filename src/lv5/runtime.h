@@ -12,5 +12,6 @@
 #include "runtime_number.h"
 #include "runtime_math.h"
 #include "runtime_error.h"
+#include "runtime_json.h"
 
 #endif  // _IV_LV5_RUNTIME_H_
@@ -1,20 +1,971 @@
 #ifndef _IV_LV5_RUNTIME_ARRAY_H_
 #define _IV_LV5_RUNTIME_ARRAY_H_
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <tr1/array>
+#include "conversions.h"
+#include "dtoa.h"
+#include "ustring.h"
+#include "ustringpiece.h"
 #include "arguments.h"
 #include "jsval.h"
-#include "error.h"
+#include "jsstring.h"
+#include "jsobject.h"
 #include "jsarray.h"
+#include "jsfunction.h"
+#include "property.h"
+#include "context.h"
+#include "error.h"
+#include "gc_template.h"
+#include "runtime_object.h"
+#include "lv5.h"
 
 namespace iv {
 namespace lv5 {
 namespace runtime {
+namespace detail {
+
+static const int kDefaultElementAttr = PropertyDescriptor::WRITABLE |
+                                       PropertyDescriptor::ENUMERABLE |
+                                       PropertyDescriptor::CONFIGURABLE;
+
+inline bool IsArray(Context* ctx, const JSObject* obj) {
+  return obj->cls() == ctx->Cls(ctx->Array_symbol()).name;
+}
+
+inline JSVal ArgumentOrUndefined(const Arguments& args, std::size_t n) {
+  return (n < args.size()) ? args[n] : JSVal(JSUndefined);
+}
+
+inline uint32_t GetLength(Context* ctx, JSObject* obj, Error* error) {
+  const JSVal length = obj->Get(ctx, ctx->length_symbol(), error);
+  if (*error) {
+    return 0;
+  }
+  const double len = length.ToNumber(ctx, error);
+  if (*error) {
+    return 0;
+  }
+  return core::DoubleToUInt32(len);
+}
+
+// relative index of slice, splice, ... clamped to [0, len]
+inline uint32_t ToRelativeIndex(double relative, uint32_t len) {
+  relative = core::DoubleToInteger(relative);
+  if (relative < 0) {
+    return static_cast<uint32_t>(std::max<double>(len + relative, 0));
+  }
+  return static_cast<uint32_t>(std::min<double>(relative, len));
+}
+
+// [[HasProperty]] and [[Get]] of element in one lookup
+// returns false if element is not present
+inline bool GetElement(Context* ctx, JSObject* obj, Symbol name,
+                       JSVal* val, Error* error) {
+  const PropertyDescriptor desc = obj->GetProperty(name);
+  if (desc.IsEmpty()) {
+    return false;
+  }
+  if (desc.IsDataDescriptor()) {
+    *val = desc.AsDataDescriptor()->data();
+  } else {
+    *val = obj->Get(ctx, name, error);
+  }
+  return true;
+}
+
+// dense fast path
+// elements in [begin, end) of array which has no holes and no accessors
+// are gathered by own property lookups only.
+// observable result is same as generic path, because [[Get]] of
+// own data property has no side effect.
+// returns false if array has hole or accessor in range
+inline bool GetDenseElements(Context* ctx, JSObject* obj,
+                             uint32_t begin, uint32_t end,
+                             JSArray::Vector* values) {
+  if (!IsArray(ctx, obj)) {
+    return false;
+  }
+  values->reserve(end - begin);
+  for (uint32_t index = begin; index < end; ++index) {
+    const PropertyDescriptor desc =
+        obj->GetOwnProperty(ctx->InternIndex(index));
+    if (!desc.IsDataDescriptor()) {
+      values->clear();
+      return false;
+    }
+    values->push_back(desc.AsDataDescriptor()->data());
+  }
+  return true;
+}
+
+// new array for results,
+// elements are collected to vector and placed to array at once
+// while no hole appears, and defined one by one after that
+class ArrayBuilder : private core::Noncopyable<ArrayBuilder>::type {
+ public:
+  explicit ArrayBuilder(Context* ctx)
+    : ctx_(ctx),
+      values_(),
+      ary_(NULL),
+      index_(0) {
+  }
+
+  void Append(const JSVal& val, Error* error) {
+    if (ary_) {
+      ary_->DefineOwnProperty(ctx_, ctx_->InternIndex(index_),
+                              DataDescriptor(val, kDefaultElementAttr),
+                              false, error);
+    } else {
+      values_.push_back(val);
+    }
+    ++index_;
+  }
+
+  void AppendHole() {
+    if (!ary_) {
+      ary_ = JSArray::New(ctx_, values_);
+    }
+    ++index_;
+  }
+
+  JSArray* Build() {
+    if (!ary_) {
+      ary_ = JSArray::New(ctx_, values_);
+    }
+    return ary_;
+  }
+
+ private:
+  Context* ctx_;
+  JSArray::Vector values_;
+  JSArray* ary_;
+  uint32_t index_;
+};
+
+inline JSFunction* GetCallbackFunction(const Arguments& args,
+                                       const char* msg,
+                                       Error* error) {
+  const JSVal callback = ArgumentOrUndefined(args, 0);
+  if (!callback.IsCallable()) {
+    error->Report(Error::Type, msg);
+    return NULL;
+  }
+  return callback.object()->AsCallable();
+}
+
+// callbackfn of every, some, forEach, map, filter
+inline JSVal CallCallback(Context* ctx,
+                          JSFunction* callback,
+                          const JSVal& this_binding,
+                          const JSVal& value,
+                          uint32_t index,
+                          JSObject* obj,
+                          Error* error) {
+  Arguments args(ctx, 3);
+  args.set_this_binding(this_binding);
+  args[0] = value;
+  args[1] = static_cast<double>(index);
+  args[2] = obj;
+  return callback->Call(args, error);
+}
+
+// comparefn of sort, which is called from stable merge sort.
+// after error occurs, every comparison returns false
+// and sorting finishes without calling comparefn
+class FunctionComparator {
+ public:
+  FunctionComparator(Context* ctx, JSFunction* comparefn, Error* error)
+    : ctx_(ctx),
+      comparefn_(comparefn),
+      error_(error) {
+  }
+
+  bool operator()(const JSVal& lhs, const JSVal& rhs) const {
+    if (*error_) {
+      return false;
+    }
+    Arguments args(ctx_, 2);
+    args[0] = lhs;
+    args[1] = rhs;
+    const JSVal res = comparefn_->Call(args, error_);
+    if (*error_) {
+      return false;
+    }
+    const double val = res.ToNumber(ctx_, error_);
+    if (*error_) {
+      return false;
+    }
+    return val < 0;
+  }
+
+ private:
+  Context* ctx_;
+  JSFunction* comparefn_;
+  Error* error_;
+};
+
+// default comparison of sort compares ToString values,
+// they are computed once for each element before sorting
+typedef std::pair<JSString*, JSVal> SortEntry;
+
+struct SortEntryLessThan {
+  bool operator()(const SortEntry& lhs, const SortEntry& rhs) const {
+    return *lhs.first < *rhs.first;
+  }
+};
+
+struct StringLessThan {
+  bool operator()(const JSVal& lhs, const JSVal& rhs) const {
+    return *lhs.string() < *rhs.string();
+  }
+};
+
+inline void AppendToBuffer(const JSVal& val, core::UString* buffer) {
+  if (val.IsString()) {
+    const JSString* const str = val.string();
+    buffer->append(str->data(), str->size());
+  } else if (val.IsNumber()) {
+    std::tr1::array<char, 80> buf;
+    const char* const str =
+        core::DoubleToCString(val.number(), buf.data(), buf.size());
+    buffer->append(str, str + std::strlen(str));
+  } else if (val.IsBoolean()) {
+    const char* const str = val.boolean() ? "true" : "false";
+    buffer->append(str, str + std::strlen(str));
+  }
+  // undefined and null are empty string
+}
+
+}  // namespace iv::lv5::runtime::detail
 
 // section 15.4.1.1 Array([item0 [, item1 [, ...]]])
 // section 15.4.2.1 new Array([item0 [, item1 [, ...]]])
 // section 15.4.2.2 new Array(len)
 inline JSVal ArrayConstructor(const Arguments& args, Error* error) {
-// TODO(Constellation) this is mock function
-  return JSArray::New(args.ctx());
+  Context* const ctx = args.ctx();
+  if (args.size() == 1 && args[0].IsNumber()) {
+    const double val = args[0].number();
+    const uint32_t len = core::DoubleToUInt32(val);
+    if (val != len) {
+      error->Report(Error::Range, "invalid array length");
+      return JSUndefined;
+    }
+    return JSArray::New(ctx, len);
+  }
+  return JSArray::New(ctx, JSArray::Vector(args.begin(), args.end()));
+}
+
+// section 15.4.3.2 Array.isArray(arg)
+inline JSVal ArrayIsArray(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.isArray", args, error);
+  const JSVal arg = detail::ArgumentOrUndefined(args, 0);
+  return JSVal::Bool(arg.IsObject() &&
+                     detail::IsArray(args.ctx(), arg.object()));
+}
+
+// section 15.4.4.5 Array.prototype.join(separator)
+inline JSVal ArrayJoin(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.join", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  const JSVal separator = detail::ArgumentOrUndefined(args, 0);
+  core::UString sep;
+  if (separator.IsUndefined()) {
+    sep.push_back(',');
+  } else {
+    const JSString* const str = separator.ToString(ctx, ERROR(error));
+    sep.assign(str->data(), str->size());
+  }
+  core::UString buffer;
+  JSArray::Vector values;
+  bool primitives = false;
+  if (detail::GetDenseElements(ctx, obj, 0, len, &values)) {
+    // ToString of primitive values has no side effect,
+    // so result length is estimated and written to one buffer
+    primitives = true;
+    std::size_t size = (len) ? sep.size() * (len - 1) : 0;
+    for (JSArray::Vector::const_iterator it = values.begin(),
+         last = values.end(); it != last; ++it) {
+      if (it->IsObject()) {
+        primitives = false;
+        break;
+      }
+      size += (it->IsString()) ? it->string()->size() : 8;
+    }
+    if (primitives) {
+      buffer.reserve(size);
+      for (JSArray::Vector::const_iterator it = values.begin(),
+           last = values.end(); it != last; ++it) {
+        if (it != values.begin()) {
+          buffer.append(sep);
+        }
+        detail::AppendToBuffer(*it, &buffer);
+      }
+    }
+  }
+  if (!primitives) {
+    for (uint32_t index = 0; index < len; ++index) {
+      if (index) {
+        buffer.append(sep);
+      }
+      const JSVal element = obj->Get(ctx, ctx->InternIndex(index),
+                                     ERROR(error));
+      if (element.IsObject()) {
+        const JSString* const str = element.ToString(ctx, ERROR(error));
+        buffer.append(str->data(), str->size());
+      } else {
+        detail::AppendToBuffer(element, &buffer);
+      }
+    }
+  }
+  return JSString::New(ctx, core::UStringPiece(buffer.data(), buffer.size()));
+}
+
+// section 15.4.4.2 Array.prototype.toString()
+inline JSVal ArrayToString(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.toString", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const JSVal join = obj->Get(ctx, ctx->Intern("join"), ERROR(error));
+  Arguments a(ctx, obj);
+  if (join.IsCallable()) {
+    return join.object()->AsCallable()->Call(a, error);
+  }
+  return ObjectToString(a, error);
+}
+
+// section 15.4.4.3 Array.prototype.toLocaleString()
+inline JSVal ArrayToLocaleString(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.toLocaleString", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  const Symbol to_locale = ctx->Intern("toLocaleString");
+  core::UString buffer;
+  for (uint32_t index = 0; index < len; ++index) {
+    if (index) {
+      buffer.push_back(',');
+    }
+    const JSVal element = obj->Get(ctx, ctx->InternIndex(index),
+                                   ERROR(error));
+    if (element.IsUndefined() || element.IsNull()) {
+      continue;
+    }
+    JSObject* const elem = element.ToObject(ctx, ERROR(error));
+    const JSVal func = elem->Get(ctx, to_locale, ERROR(error));
+    if (!func.IsCallable()) {
+      error->Report(Error::Type, "toLocaleString is not callable");
+      return JSUndefined;
+    }
+    const JSVal res =
+        func.object()->AsCallable()->Call(Arguments(ctx, elem), ERROR(error));
+    const JSString* const str = res.ToString(ctx, ERROR(error));
+    buffer.append(str->data(), str->size());
+  }
+  return JSString::New(ctx, core::UStringPiece(buffer.data(), buffer.size()));
+}
+
+// section 15.4.4.4 Array.prototype.concat([item1[, item2[, ...]]])
+inline JSVal ArrayConcat(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.concat", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  detail::ArrayBuilder builder(ctx);
+  for (std::size_t n = 0, last = args.size(); n <= last; ++n) {
+    const JSVal item = (n == 0) ? JSVal(obj) : args[n - 1];
+    if (item.IsObject() && detail::IsArray(ctx, item.object())) {
+      JSObject* const elem = item.object();
+      const uint32_t len = detail::GetLength(ctx, elem, ERROR(error));
+      for (uint32_t index = 0; index < len; ++index) {
+        JSVal value;
+        const bool present = detail::GetElement(ctx, elem,
+                                                ctx->InternIndex(index),
+                                                &value, ERROR(error));
+        if (present) {
+          builder.Append(value, ERROR(error));
+        } else {
+          builder.AppendHole();
+        }
+      }
+    } else {
+      builder.Append(item, ERROR(error));
+    }
+  }
+  return builder.Build();
+}
+
+// section 15.4.4.6 Array.prototype.pop()
+inline JSVal ArrayPop(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.pop", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  if (len == 0) {
+    obj->Put(ctx, ctx->length_symbol(), 0.0, true, ERROR(error));
+    return JSUndefined;
+  }
+  const Symbol index = ctx->InternIndex(len - 1);
+  const JSVal element = obj->Get(ctx, index, ERROR(error));
+  obj->Delete(index, true, ERROR(error));
+  obj->Put(ctx, ctx->length_symbol(),
+           static_cast<double>(len - 1), true, ERROR(error));
+  return element;
+}
+
+// section 15.4.4.7 Array.prototype.push([item1 [, item2 [, ...]]])
+inline JSVal ArrayPush(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.push", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  double n = len;
+  Arguments::const_iterator it = args.begin();
+  const PropertyDescriptor length = obj->GetOwnProperty(ctx->length_symbol());
+  if (detail::IsArray(ctx, obj) && obj->IsExtensible() &&
+      length.IsDataDescriptor() && length.IsWritable()) {
+    // fast path, element is defined directly if no property of the index
+    // exists in prototype chain (so [[Put]] creates own data property).
+    // length is updated once
+    for (const Arguments::const_iterator last = args.end();
+         it != last && n < 4294967295.0; ++it, n += 1) {
+      const Symbol index = ctx->InternIndex(static_cast<uint32_t>(n));
+      if (obj->prototype() && obj->prototype()->HasProperty(index)) {
+        break;
+      }
+      obj->JSObject::DefineOwnProperty(
+          ctx, index, DataDescriptor(*it, detail::kDefaultElementAttr),
+          true, ERROR(error));
+    }
+  }
+  for (const Arguments::const_iterator last = args.end();
+       it != last; ++it, n += 1) {
+    JSString* const index = JSVal(n).ToString(ctx, ERROR(error));
+    obj->Put(ctx, ctx->Intern(index->ToPiece()), *it, true, ERROR(error));
+  }
+  obj->Put(ctx, ctx->length_symbol(), n, true, ERROR(error));
+  return n;
+}
+
+// section 15.4.4.8 Array.prototype.reverse()
+inline JSVal ArrayReverse(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.reverse", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  const uint32_t middle = len / 2;
+  for (uint32_t lower = 0; lower != middle; ++lower) {
+    const Symbol lower_p = ctx->InternIndex(lower);
+    const Symbol upper_p = ctx->InternIndex(len - lower - 1);
+    JSVal lower_value, upper_value;
+    const bool lower_exists =
+        detail::GetElement(ctx, obj, lower_p, &lower_value, ERROR(error));
+    const bool upper_exists =
+        detail::GetElement(ctx, obj, upper_p, &upper_value, ERROR(error));
+    if (upper_exists) {
+      obj->Put(ctx, lower_p, upper_value, true, ERROR(error));
+    } else if (lower_exists) {
+      obj->Delete(lower_p, true, ERROR(error));
+    }
+    if (lower_exists) {
+      obj->Put(ctx, upper_p, lower_value, true, ERROR(error));
+    } else if (upper_exists) {
+      obj->Delete(upper_p, true, ERROR(error));
+    }
+  }
+  return obj;
+}
+
+// section 15.4.4.9 Array.prototype.shift()
+inline JSVal ArrayShift(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.shift", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  if (len == 0) {
+    obj->Put(ctx, ctx->length_symbol(), 0.0, true, ERROR(error));
+    return JSUndefined;
+  }
+  const JSVal first = obj->Get(ctx, ctx->InternIndex(0), ERROR(error));
+  for (uint32_t k = 1; k < len; ++k) {
+    const Symbol to = ctx->InternIndex(k - 1);
+    JSVal value;
+    const bool present = detail::GetElement(ctx, obj, ctx->InternIndex(k),
+                                            &value, ERROR(error));
+    if (present) {
+      obj->Put(ctx, to, value, true, ERROR(error));
+    } else {
+      obj->Delete(to, true, ERROR(error));
+    }
+  }
+  obj->Delete(ctx->InternIndex(len - 1), true, ERROR(error));
+  obj->Put(ctx, ctx->length_symbol(),
+           static_cast<double>(len - 1), true, ERROR(error));
+  return first;
+}
+
+// section 15.4.4.10 Array.prototype.slice(start, end)
+inline JSVal ArraySlice(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.slice", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  const double start =
+      detail::ArgumentOrUndefined(args, 0).ToNumber(ctx, ERROR(error));
+  const uint32_t k = detail::ToRelativeIndex(start, len);
+  uint32_t final = len;
+  const JSVal end = detail::ArgumentOrUndefined(args, 1);
+  if (!end.IsUndefined()) {
+    const double relative_end = end.ToNumber(ctx, ERROR(error));
+    final = detail::ToRelativeIndex(relative_end, len);
+  }
+  if (k >= final) {
+    return JSArray::New(ctx);
+  }
+  JSArray::Vector values;
+  if (detail::GetDenseElements(ctx, obj, k, final, &values)) {
+    return JSArray::New(ctx, values);
+  }
+  detail::ArrayBuilder builder(ctx);
+  for (uint32_t index = k; index < final; ++index) {
+    JSVal value;
+    const bool present = detail::GetElement(ctx, obj, ctx->InternIndex(index),
+                                            &value, ERROR(error));
+    if (present) {
+      builder.Append(value, ERROR(error));
+    } else {
+      builder.AppendHole();
+    }
+  }
+  return builder.Build();
+}
+
+// section 15.4.4.11 Array.prototype.sort(comparefn)
+// elements are sorted by stable merge sort.
+// comparefn may be inconsistent, merge sort never accesses out of range
+inline JSVal ArraySort(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.sort", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  const JSVal comparefn = detail::ArgumentOrUndefined(args, 0);
+  if (!comparefn.IsUndefined() && !comparefn.IsCallable()) {
+    error->Report(Error::Type,
+                  "Array.prototype.sort comparefn is not callable");
+    return JSUndefined;
+  }
+
+  // undefined values are placed after sorted values, and holes after them
+  JSArray::Vector values;
+  uint32_t undefineds = 0;
+  if (!detail::GetDenseElements(ctx, obj, 0, len, &values)) {
+    for (uint32_t index = 0; index < len; ++index) {
+      JSVal value;
+      const bool present = detail::GetElement(ctx, obj, ctx->InternIndex(index),
+                                              &value, ERROR(error));
+      if (present) {
+        values.push_back(value);
+      }
+    }
+  }
+  JSArray::Vector::iterator defined_end =
+      std::remove_if(values.begin(), values.end(),
+                     std::mem_fun_ref(&JSVal::IsUndefined));
+  undefineds = std::distance(defined_end, values.end());
+  values.erase(defined_end, values.end());
+
+  if (comparefn.IsCallable()) {
+    // stable_sort moves values to temporary buffer, which is not traced,
+    // and comparefn may cause GC. so values are kept alive by this copy
+    const JSArray::Vector alive(values);
+    std::stable_sort(values.begin(), values.end(),
+                     detail::FunctionComparator(
+                         ctx, comparefn.object()->AsCallable(), error));
+    if (*error) {
+      return JSUndefined;
+    }
+  } else if (std::find_if(values.begin(), values.end(),
+                          std::not1(std::mem_fun_ref(&JSVal::IsString))) ==
+             values.end()) {
+    // all values are strings, compared directly
+    std::stable_sort(values.begin(), values.end(), detail::StringLessThan());
+  } else {
+    GCVector<detail::SortEntry>::type entries;
+    entries.reserve(values.size());
+    for (JSArray::Vector::const_iterator it = values.begin(),
+         last = values.end(); it != last; ++it) {
+      JSString* const str = it->ToString(ctx, ERROR(error));
+      entries.push_back(std::make_pair(str, *it));
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+                     detail::SortEntryLessThan());
+    for (std::size_t i = 0, n = entries.size(); i < n; ++i) {
+      values[i] = entries[i].second;
+    }
+  }
+
+  uint32_t index = 0;
+  for (JSArray::Vector::const_iterator it = values.begin(),
+       last = values.end(); it != last; ++it, ++index) {
+    obj->Put(ctx, ctx->InternIndex(index), *it, true, ERROR(error));
+  }
+  for (uint32_t i = 0; i < undefineds; ++i, ++index) {
+    obj->Put(ctx, ctx->InternIndex(index), JSUndefined, true, ERROR(error));
+  }
+  for (; index < len; ++index) {
+    obj->Delete(ctx->InternIndex(index), true, ERROR(error));
+  }
+  return obj;
+}
+
+// section 15.4.4.12
+// Array.prototype.splice(start, deleteCount [, item1 [, item2 [, ...]]])
+inline JSVal ArraySplice(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.splice", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  const double start =
+      detail::ArgumentOrUndefined(args, 0).ToNumber(ctx, ERROR(error));
+  const uint32_t actual_start = detail::ToRelativeIndex(start, len);
+  const double delete_count =
+      detail::ArgumentOrUndefined(args, 1).ToNumber(ctx, ERROR(error));
+  const uint32_t actual_delete_count = static_cast<uint32_t>(
+      std::min<double>(
+          std::max<double>(core::DoubleToInteger(delete_count), 0),
+          len - actual_start));
+
+  // removed elements
+  detail::ArrayBuilder builder(ctx);
+  for (uint32_t k = 0; k < actual_delete_count; ++k) {
+    JSVal value;
+    const bool present =
+        detail::GetElement(ctx, obj, ctx->InternIndex(actual_start + k),
+                           &value, ERROR(error));
+    if (present) {
+      builder.Append(value, ERROR(error));
+    } else {
+      builder.AppendHole();
+    }
+  }
+  JSArray* const removed = builder.Build();
+
+  const uint32_t item_count = (args.size() > 2) ? args.size() - 2 : 0;
+  if (item_count < actual_delete_count) {
+    for (uint32_t k = actual_start; k < len - actual_delete_count; ++k) {
+      const Symbol to = ctx->InternIndex(k + item_count);
+      JSVal value;
+      const bool present =
+          detail::GetElement(ctx, obj,
+                             ctx->InternIndex(k + actual_delete_count),
+                             &value, ERROR(error));
+      if (present) {
+        obj->Put(ctx, to, value, true, ERROR(error));
+      } else {
+        obj->Delete(to, true, ERROR(error));
+      }
+    }
+    for (uint32_t k = len; k > len - actual_delete_count + item_count; --k) {
+      obj->Delete(ctx->InternIndex(k - 1), true, ERROR(error));
+    }
+  } else if (item_count > actual_delete_count) {
+    for (uint32_t k = len - actual_delete_count; k > actual_start; --k) {
+      const Symbol to = ctx->InternIndex(k + item_count - 1);
+      JSVal value;
+      const bool present =
+          detail::GetElement(ctx, obj,
+                             ctx->InternIndex(k + actual_delete_count - 1),
+                             &value, ERROR(error));
+      if (present) {
+        obj->Put(ctx, to, value, true, ERROR(error));
+      } else {
+        obj->Delete(to, true, ERROR(error));
+      }
+    }
+  }
+  for (uint32_t k = 0; k < item_count; ++k) {
+    obj->Put(ctx, ctx->InternIndex(actual_start + k),
+             args[k + 2], true, ERROR(error));
+  }
+  obj->Put(ctx, ctx->length_symbol(),
+           static_cast<double>(len - actual_delete_count + item_count),
+           true, ERROR(error));
+  return removed;
+}
+
+// section 15.4.4.13 Array.prototype.unshift([item1 [, item2 [, ...]]])
+inline JSVal ArrayUnshift(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.unshift", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  const uint32_t arg_count = args.size();
+  if (arg_count) {
+    for (uint32_t k = len; k > 0; --k) {
+      const Symbol to = ctx->InternIndex(k + arg_count - 1);
+      JSVal value;
+      const bool present = detail::GetElement(ctx, obj, ctx->InternIndex(k - 1),
+                                              &value, ERROR(error));
+      if (present) {
+        obj->Put(ctx, to, value, true, ERROR(error));
+      } else {
+        obj->Delete(to, true, ERROR(error));
+      }
+    }
+    for (uint32_t j = 0; j < arg_count; ++j) {
+      obj->Put(ctx, ctx->InternIndex(j), args[j], true, ERROR(error));
+    }
+  }
+  const double new_len = static_cast<double>(len) + arg_count;
+  obj->Put(ctx, ctx->length_symbol(), new_len, true, ERROR(error));
+  return new_len;
+}
+
+// section 15.4.4.14 Array.prototype.indexOf(searchElement [, fromIndex])
+inline JSVal ArrayIndexOf(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.indexOf", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  if (len == 0) {
+    return -1.0;
+  }
+  const JSVal search = detail::ArgumentOrUndefined(args, 0);
+  double n = 0;
+  if (args.size() > 1) {
+    const double from_index = args[1].ToNumber(ctx, ERROR(error));
+    n = core::DoubleToInteger(from_index);
+  }
+  if (n >= len) {
+    return -1.0;
+  }
+  uint32_t k = (n >= 0) ?
+      static_cast<uint32_t>(n) :
+      static_cast<uint32_t>(std::max<double>(len + n, 0));
+  for (; k < len; ++k) {
+    JSVal value;
+    const bool present = detail::GetElement(ctx, obj, ctx->InternIndex(k),
+                                            &value, ERROR(error));
+    if (present && StrictEqual(search, value)) {
+      return static_cast<double>(k);
+    }
+  }
+  return -1.0;
+}
+
+// section 15.4.4.15
+// Array.prototype.lastIndexOf(searchElement [, fromIndex])
+inline JSVal ArrayLastIndexOf(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.lastIndexOf", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  if (len == 0) {
+    return -1.0;
+  }
+  const JSVal search = detail::ArgumentOrUndefined(args, 0);
+  double n = static_cast<double>(len) - 1;
+  if (args.size() > 1) {
+    const double from_index = args[1].ToNumber(ctx, ERROR(error));
+    n = core::DoubleToInteger(from_index);
+  }
+  double k = (n >= 0) ? std::min<double>(n, len - 1) : len + n;
+  for (; k >= 0; k -= 1) {
+    JSVal value;
+    const bool present =
+        detail::GetElement(ctx, obj,
+                           ctx->InternIndex(static_cast<uint32_t>(k)),
+                           &value, ERROR(error));
+    if (present && StrictEqual(search, value)) {
+      return k;
+    }
+  }
+  return -1.0;
+}
+
+// section 15.4.4.16 Array.prototype.every(callbackfn [, thisArg])
+inline JSVal ArrayEvery(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.every", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  JSFunction* const callback = detail::GetCallbackFunction(
+      args, "Array.prototype.every callbackfn is not callable", ERROR(error));
+  const JSVal this_binding = detail::ArgumentOrUndefined(args, 1);
+  for (uint32_t k = 0; k < len; ++k) {
+    JSVal value;
+    const bool present = detail::GetElement(ctx, obj, ctx->InternIndex(k),
+                                            &value, ERROR(error));
+    if (present) {
+      const JSVal res = detail::CallCallback(ctx, callback, this_binding,
+                                             value, k, obj, ERROR(error));
+      const bool test = res.ToBoolean(ERROR(error));
+      if (!test) {
+        return JSFalse;
+      }
+    }
+  }
+  return JSTrue;
+}
+
+// section 15.4.4.17 Array.prototype.some(callbackfn [, thisArg])
+inline JSVal ArraySome(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.some", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  JSFunction* const callback = detail::GetCallbackFunction(
+      args, "Array.prototype.some callbackfn is not callable", ERROR(error));
+  const JSVal this_binding = detail::ArgumentOrUndefined(args, 1);
+  for (uint32_t k = 0; k < len; ++k) {
+    JSVal value;
+    const bool present = detail::GetElement(ctx, obj, ctx->InternIndex(k),
+                                            &value, ERROR(error));
+    if (present) {
+      const JSVal res = detail::CallCallback(ctx, callback, this_binding,
+                                             value, k, obj, ERROR(error));
+      const bool test = res.ToBoolean(ERROR(error));
+      if (test) {
+        return JSTrue;
+      }
+    }
+  }
+  return JSFalse;
+}
+
+// section 15.4.4.18 Array.prototype.forEach(callbackfn [, thisArg])
+inline JSVal ArrayForEach(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.forEach", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  JSFunction* const callback = detail::GetCallbackFunction(
+      args,
+      "Array.prototype.forEach callbackfn is not callable", ERROR(error));
+  const JSVal this_binding = detail::ArgumentOrUndefined(args, 1);
+  for (uint32_t k = 0; k < len; ++k) {
+    JSVal value;
+    const bool present = detail::GetElement(ctx, obj, ctx->InternIndex(k),
+                                            &value, ERROR(error));
+    if (present) {
+      detail::CallCallback(ctx, callback, this_binding,
+                           value, k, obj, ERROR(error));
+    }
+  }
+  return JSUndefined;
+}
+
+// section 15.4.4.19 Array.prototype.map(callbackfn [, thisArg])
+inline JSVal ArrayMap(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.map", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  JSFunction* const callback = detail::GetCallbackFunction(
+      args, "Array.prototype.map callbackfn is not callable", ERROR(error));
+  const JSVal this_binding = detail::ArgumentOrUndefined(args, 1);
+  detail::ArrayBuilder builder(ctx);
+  for (uint32_t k = 0; k < len; ++k) {
+    JSVal value;
+    const bool present = detail::GetElement(ctx, obj, ctx->InternIndex(k),
+                                            &value, ERROR(error));
+    if (present) {
+      const JSVal mapped = detail::CallCallback(ctx, callback, this_binding,
+                                                value, k, obj, ERROR(error));
+      builder.Append(mapped, ERROR(error));
+    } else {
+      builder.AppendHole();
+    }
+  }
+  JSArray* const ary = builder.Build();
+  // A is created by new Array(len)
+  ary->Put(ctx, ctx->length_symbol(),
+           static_cast<double>(len), false, ERROR(error));
+  return ary;
+}
+
+// section 15.4.4.20 Array.prototype.filter(callbackfn [, thisArg])
+inline JSVal ArrayFilter(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.filter", args, error);
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  JSFunction* const callback = detail::GetCallbackFunction(
+      args,
+      "Array.prototype.filter callbackfn is not callable", ERROR(error));
+  const JSVal this_binding = detail::ArgumentOrUndefined(args, 1);
+  detail::ArrayBuilder builder(ctx);
+  for (uint32_t k = 0; k < len; ++k) {
+    JSVal value;
+    const bool present = detail::GetElement(ctx, obj, ctx->InternIndex(k),
+                                            &value, ERROR(error));
+    if (present) {
+      const JSVal res = detail::CallCallback(ctx, callback, this_binding,
+                                             value, k, obj, ERROR(error));
+      const bool selected = res.ToBoolean(ERROR(error));
+      if (selected) {
+        builder.Append(value, ERROR(error));
+      }
+    }
+  }
+  return builder.Build();
+}
+
+// section 15.4.4.21 Array.prototype.reduce(callbackfn [, initialValue])
+// section 15.4.4.22 Array.prototype.reduceRight(callbackfn [, initialValue])
+template<bool kRight>
+inline JSVal ArrayReduceImpl(const Arguments& args, Error* error) {
+  Context* const ctx = args.ctx();
+  JSObject* const obj = args.this_binding().ToObject(ctx, ERROR(error));
+  const uint32_t len = detail::GetLength(ctx, obj, ERROR(error));
+  JSFunction* const callback = detail::GetCallbackFunction(
+      args, "reduce callbackfn is not callable", ERROR(error));
+  uint32_t k = 0;
+  JSVal accumulator;
+  if (args.size() > 1) {
+    accumulator = args[1];
+  } else {
+    bool present = false;
+    for (; !present && k < len; ++k) {
+      const uint32_t index = kRight ? len - k - 1 : k;
+      present = detail::GetElement(ctx, obj, ctx->InternIndex(index),
+                                   &accumulator, ERROR(error));
+    }
+    if (!present) {
+      error->Report(Error::Type, "reduce of empty array with no initial value");
+      return JSUndefined;
+    }
+  }
+  for (; k < len; ++k) {
+    const uint32_t index = kRight ? len - k - 1 : k;
+    JSVal value;
+    const bool present = detail::GetElement(ctx, obj, ctx->InternIndex(index),
+                                            &value, ERROR(error));
+    if (present) {
+      Arguments a(ctx, 4);
+      a[0] = accumulator;
+      a[1] = value;
+      a[2] = static_cast<double>(index);
+      a[3] = obj;
+      accumulator = callback->Call(a, ERROR(error));
+    }
+  }
+  return accumulator;
+}
+
+inline JSVal ArrayReduce(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.reduce", args, error);
+  return ArrayReduceImpl<false>(args, error);
+}
+
+inline JSVal ArrayReduceRight(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("Array.prototype.reduceRight", args, error);
+  return ArrayReduceImpl<true>(args, error);
 }
 
 } } }  // namespace iv::lv5::runtime
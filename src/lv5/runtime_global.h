@@ -17,11 +17,24 @@ namespace lv5 {
 namespace runtime {
 namespace detail {
 
-inline JSScript* CompileScript(Context* ctx, JSString* str, Error* error) {
+// compiled eval code is cached in Context,
+// so same source is parsed only once
+inline JSScript* CompileScript(Context* ctx, JSString* str,
+                               bool direct, Error* error) {
+  const bool strict = ctx->IsStrict();
+  if (JSScript* const script =
+      ctx->eval_cache()->Lookup(str, strict, direct)) {
+    return script;
+  }
+  // evicted scripts hold factories allocated outside of GC heap,
+  // so collect them periodically
+  if (ctx->IsShouldGC()) {
+    GC_gcollect();
+  }
   std::tr1::shared_ptr<EvalSource> const src(new EvalSource(str));
   AstFactory* const factory = new AstFactory(ctx);
   core::Parser<AstFactory, EvalSource> parser(factory, src.get());
-  parser.set_strict(ctx->IsStrict());
+  parser.set_strict(strict);
   const iv::lv5::FunctionLiteral* const eval = parser.ParseProgram();
   if (!eval) {
     delete factory;
@@ -29,7 +42,13 @@ inline JSScript* CompileScript(Context* ctx, JSString* str, Error* error) {
                   parser.error());
     return NULL;
   } else {
-    return iv::lv5::JSEvalScript<EvalSource>::New(ctx, eval, factory, src);
+    JSScript* const script =
+        iv::lv5::JSEvalScript<EvalSource>::New(ctx, eval, factory, src);
+    // cached script keeps its factory alive
+    const std::size_t cost = sizeof(AstFactory) +
+        factory->upstream_size() + str->size() * sizeof(uc16);
+    ctx->eval_cache()->Insert(str, strict, direct, script, cost);
+    return script;
   }
 }
 
@@ -45,7 +64,8 @@ inline JSVal InDirectCallToEval(const Arguments& args, Error* error) {
   }
   Context* const ctx = args.ctx();
   JSScript* const script = detail::CompileScript(args.ctx(),
-                                                 first.string(), ERROR(error));
+                                                 first.string(),
+                                                 false, ERROR(error));
   if (script->function()->strict()) {
     JSDeclEnv* const env =
         Interpreter::NewDeclarativeEnvironment(ctx, ctx->lexical_env());
@@ -58,9 +78,6 @@ inline JSVal InDirectCallToEval(const Arguments& args, Error* error) {
   } else {
     ctx->Run(script);
   }
-  if (ctx->IsShouldGC()) {
-    GC_gcollect();
-  }
   return ctx->ret();
 }
 
@@ -79,7 +96,8 @@ inline JSVal DirectCallToEval(const Arguments& args, Error* error) {
   }
   Context* const ctx = args.ctx();
   JSScript* const script = detail::CompileScript(args.ctx(),
-                                                 first.string(), ERROR(error));
+                                                 first.string(),
+                                                 true, ERROR(error));
   if (script->function()->strict()) {
     JSDeclEnv* const env =
         Interpreter::NewDeclarativeEnvironment(ctx, ctx->lexical_env());
@@ -97,9 +115,6 @@ inline JSVal DirectCallToEval(const Arguments& args, Error* error) {
                                                 false);
     ctx->Run(script);
   }
-  if (ctx->IsShouldGC()) {
-    GC_gcollect();
-  }
   return ctx->ret();
 }
 
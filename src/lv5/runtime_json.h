@@ -0,0 +1,156 @@
+#ifndef _IV_LV5_RUNTIME_JSON_H_
+#define _IV_LV5_RUNTIME_JSON_H_
+#include <vector>
+#include <algorithm>
+#include "conversions.h"
+#include "ustring.h"
+#include "arguments.h"
+#include "jsval.h"
+#include "jsstring.h"
+#include "jsobject.h"
+#include "jsfunction.h"
+#include "property.h"
+#include "context.h"
+#include "error.h"
+#include "json.h"
+#include "lv5.h"
+
+namespace iv {
+namespace lv5 {
+namespace runtime {
+namespace detail {
+
+// section 15.12.2 abstract operation Walk
+inline JSVal JSONWalk(Context* ctx, JSObject* holder, Symbol name,
+                      JSFunction* reviver, Error* error) {
+  const JSVal val = holder->Get(ctx, name, ERROR(error));
+  if (val.IsObject()) {
+    JSObject* const obj = val.object();
+    std::vector<Symbol> keys;
+    if (obj->cls() == ctx->Cls(ctx->Array_symbol()).name) {
+      const JSVal length = obj->Get(ctx, ctx->length_symbol(), ERROR(error));
+      const double len_double = length.ToNumber(ctx, ERROR(error));
+      const uint32_t len = core::DoubleToUInt32(len_double);
+      for (uint32_t index = 0; index < len; ++index) {
+        keys.push_back(ctx->InternIndex(index));
+      }
+    } else {
+      lv5::detail::GetOwnEnumerablePropertyNames(obj, &keys);
+    }
+    for (std::vector<Symbol>::const_iterator it = keys.begin(),
+         last = keys.end(); it != last; ++it) {
+      const JSVal element = JSONWalk(ctx, obj, *it, reviver, ERROR(error));
+      if (element.IsUndefined()) {
+        obj->Delete(*it, false, ERROR(error));
+      } else {
+        obj->DefineOwnProperty(ctx, *it,
+                               DataDescriptor(
+                                   element,
+                                   PropertyDescriptor::WRITABLE |
+                                   PropertyDescriptor::ENUMERABLE |
+                                   PropertyDescriptor::CONFIGURABLE),
+                               false, ERROR(error));
+      }
+    }
+  }
+  Arguments args(ctx, 2);
+  args.set_this_binding(holder);
+  args[0] = ctx->ToString(name);
+  args[1] = val;
+  return reviver->Call(args, error);
+}
+
+}  // namespace iv::lv5::runtime::detail
+
+// section 15.12.2 parse(text [, reviver])
+inline JSVal JSONParse(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("JSON.parse", args, error);
+  Context* const ctx = args.ctx();
+  const JSVal text = (args.size() > 0) ? args[0] : JSVal(JSUndefined);
+  JSString* const str = text.ToString(ctx, ERROR(error));
+  JSONParser parser(ctx, str->ToPiece());
+  const JSVal result = parser.Parse(ERROR(error));
+  if (args.size() > 1 && args[1].IsCallable()) {
+    JSObject* const root = JSObject::New(ctx);
+    const Symbol empty = ctx->Intern("");
+    root->DefineOwnProperty(ctx, empty,
+                            DataDescriptor(result,
+                                           PropertyDescriptor::WRITABLE |
+                                           PropertyDescriptor::ENUMERABLE |
+                                           PropertyDescriptor::CONFIGURABLE),
+                            false, ERROR(error));
+    return detail::JSONWalk(ctx, root, empty,
+                            args[1].object()->AsCallable(), error);
+  }
+  return result;
+}
+
+// section 15.12.3 stringify(value [, replacer [, space]])
+inline JSVal JSONStringify(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("JSON.stringify", args, error);
+  Context* const ctx = args.ctx();
+  const JSVal value = (args.size() > 0) ? args[0] : JSVal(JSUndefined);
+
+  // step 4
+  JSFunction* replacer = NULL;
+  std::vector<Symbol> property_list;
+  bool has_property_list = false;
+  if (args.size() > 1 && args[1].IsObject()) {
+    JSObject* const obj = args[1].object();
+    if (obj->IsCallable()) {
+      replacer = obj->AsCallable();
+    } else if (obj->cls() == ctx->Cls(ctx->Array_symbol()).name) {
+      has_property_list = true;
+      const JSVal length = obj->Get(ctx, ctx->length_symbol(), ERROR(error));
+      const double len_double = length.ToNumber(ctx, ERROR(error));
+      const uint32_t len = core::DoubleToUInt32(len_double);
+      for (uint32_t index = 0; index < len; ++index) {
+        const JSVal v = obj->Get(ctx, ctx->InternIndex(index), ERROR(error));
+        if (!(v.IsString() || v.IsNumber() ||
+              (v.IsObject() && (v.object()->AsStringObject() ||
+                                v.object()->AsNumberObject())))) {
+          continue;
+        }
+        JSString* const item = v.ToString(ctx, ERROR(error));
+        const Symbol sym = ctx->Intern(item->ToPiece());
+        if (std::find(property_list.begin(),
+                      property_list.end(), sym) == property_list.end()) {
+          property_list.push_back(sym);
+        }
+      }
+    }
+  }
+
+  // step 5 - 8
+  JSVal space = (args.size() > 2) ? args[2] : JSVal(JSUndefined);
+  if (space.IsObject()) {
+    if (space.object()->AsNumberObject()) {
+      space = space.ToNumber(ctx, ERROR(error));
+    } else if (space.object()->AsStringObject()) {
+      space = space.ToString(ctx, ERROR(error));
+    }
+  }
+  core::UString gap;
+  if (space.IsNumber()) {
+    const double n = std::min(10.0, core::DoubleToInteger(space.number()));
+    if (n >= 1) {
+      gap.assign(static_cast<std::size_t>(n), ' ');
+    }
+  } else if (space.IsString()) {
+    const JSString* const str = space.string();
+    gap.assign(str->data(), std::min<std::size_t>(10, str->size()));
+  }
+
+  JSONStringifier stringifier(ctx,
+                              replacer,
+                              has_property_list ? &property_list : NULL,
+                              gap);
+  JSString* const result = stringifier.Stringify(value, ERROR(error));
+  if (!result) {
+    return JSUndefined;
+  }
+  return result;
+}
+
+} } }  // namespace iv::lv5::runtime
+#endif  // _IV_LV5_RUNTIME_JSON_H_
@@ -4,6 +4,7 @@
 #include "arguments.h"
 #include "jsval.h"
 #include "context.h"
+#include "jsfunction.h"
 #include "error.h"
 #include "lv5.h"
 
@@ -18,6 +19,26 @@ static inline bool IsInfinity(double val) {
   return !std::isfinite(val) && !std::isnan(val);
 }
 
+inline double Round(double x) {
+  const double res = std::ceil(x);
+  if (res - x > 0.5) {
+    return res - 1;
+  } else {
+    return res;
+  }
+}
+
+inline double Pow(double x, double y) {
+  if (y == 0) {
+    return 1.0;
+  } else if (std::isnan(y) ||
+             ((x == 1 || x == -1) && IsInfinity(y))) {
+    return std::numeric_limits<double>::quiet_NaN();
+  } else {
+    return std::pow(x, y);
+  }
+}
+
 }  // namespace iv::lv5::runtime::detail
 
 inline JSVal MathAbs(const Arguments& args, Error* error) {
@@ -146,14 +167,7 @@ inline JSVal MathPow(const Arguments& args, Error* error) {
   if (args.size() > 1) {
     const double x = args[0].ToNumber(args.ctx(), ERROR(error));
     const double y = args[1].ToNumber(args.ctx(), ERROR(error));
-    if (y == 0) {
-      return 1.0;
-    } else if (std::isnan(y) ||
-               ((x == 1 || x == -1) && detail::IsInfinity(y))) {
-      return JSNaN;
-    } else {
-      return std::pow(x, y);
-    }
+    return detail::Pow(x, y);
   }
   return JSNaN;
 }
@@ -167,12 +181,7 @@ inline JSVal MathRound(const Arguments& args, Error* error) {
   CONSTRUCTOR_CHECK("Math.round", args, error);
   if (args.size() > 0) {
     const double x = args[0].ToNumber(args.ctx(), ERROR(error));
-    const double res = std::ceil(x);
-    if (res - x > 0.5) {
-      return res - 1;
-    } else {
-      return res;
-    }
+    return detail::Round(x);
   }
   return JSNaN;
 }
@@ -204,5 +213,68 @@ inline JSVal MathTan(const Arguments& args, Error* error) {
   return JSNaN;
 }
 
+// Math functions executed inline at call sites.
+// when func is one of the original builtins and all arguments are numbers,
+// result is computed without conversions and returns true.
+// replaced builtins are never matched, because function pointer differs.
+// func is matched first, so other native calls do not scan arguments.
+inline bool MathIntrinsic(JSNativeFunction::value_type func,
+                          const Arguments& args, double* res) {
+  const std::size_t size = args.size();
+  if (func == &MathMax || func == &MathMin) {
+    const bool is_max = func == &MathMax;
+    double val = (is_max) ? -detail::kMathInfinity : detail::kMathInfinity;
+    for (Arguments::const_iterator it = args.begin(),
+         last = args.end(); it != last; ++it) {
+      if (!it->IsNumber()) {
+        return false;
+      }
+      const double x = it->number();
+      if (std::isnan(val)) {
+        continue;
+      } else if (std::isnan(x) || ((is_max) ? (x > val) : (x < val))) {
+        val = x;
+      }
+    }
+    *res = val;
+    return true;
+  }
+  if (func == &MathPow) {
+    if (size == 2 && args[0].IsNumber() && args[1].IsNumber()) {
+      *res = detail::Pow(args[0].number(), args[1].number());
+      return true;
+    }
+    return false;
+  }
+  if (size != 1) {
+    return false;
+  }
+  if (func == &MathFloor || func == &MathCeil || func == &MathAbs ||
+      func == &MathSqrt || func == &MathRound ||
+      func == &MathSin || func == &MathCos) {
+    if (!args[0].IsNumber()) {
+      return false;
+    }
+    const double x = args[0].number();
+    if (func == &MathFloor) {
+      *res = std::floor(x);
+    } else if (func == &MathCeil) {
+      *res = std::ceil(x);
+    } else if (func == &MathAbs) {
+      *res = std::abs(x);
+    } else if (func == &MathSqrt) {
+      *res = std::sqrt(x);
+    } else if (func == &MathRound) {
+      *res = detail::Round(x);
+    } else if (func == &MathSin) {
+      *res = std::sin(x);
+    } else {
+      *res = std::cos(x);
+    }
+    return true;
+  }
+  return false;
+}
+
 } } }  // namespace iv::lv5::runtime
 #endif  // _IV_LV5_RUNTIME_MATH_H_
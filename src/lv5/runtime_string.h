@@ -1,13 +1,21 @@
 #ifndef _IV_LV5_RUNTIME_STRING_H_
 #define _IV_LV5_RUNTIME_STRING_H_
+#include <cmath>
 #include <vector>
+#include <limits>
+#include <algorithm>
+#include <unicode/ustring.h>
+#include "chars.h"
 #include "ustring.h"
 #include "ustringpiece.h"
 #include "conversions.h"
+#include "string_search.h"
 #include "arguments.h"
 #include "jsval.h"
 #include "error.h"
 #include "jsstring.h"
+#include "jsarray.h"
+#include "context.h"
 
 namespace iv {
 namespace lv5 {
@@ -30,6 +38,64 @@ static inline JSVal StringToStringValueOfImpl(const Arguments& args,
   }
 }
 
+// JSString is immutable, so whole string is returned as is
+inline JSString* SubString(Context* ctx, JSString* str,
+                           std::size_t from, std::size_t to) {
+  if (from == 0 && to == str->size()) {
+    return str;
+  }
+  return JSString::New(ctx, core::UStringPiece(str->data() + from, to - from));
+}
+
+// ASCII string is converted without ICU,
+// and string which has no characters to convert is returned as is
+template<bool kUpper>
+inline JSString* ConvertCase(Context* ctx, JSString* str) {
+  const uc16 from = kUpper ? 'a' : 'A';
+  const uc16 to = kUpper ? 'z' : 'Z';
+  bool ascii = true;
+  bool changed = false;
+  for (JSString::const_iterator it = str->begin(),
+       last = str->end(); it != last; ++it) {
+    if (!core::Chars::IsASCII(*it)) {
+      ascii = false;
+      break;
+    }
+    if (from <= *it && *it <= to) {
+      changed = true;
+    }
+  }
+  if (ascii) {
+    if (!changed) {
+      return str;
+    }
+    core::UString result(str->begin(), str->end());
+    for (core::UString::iterator it = result.begin(),
+         last = result.end(); it != last; ++it) {
+      if (from <= *it && *it <= to) {
+        *it ^= 0x20;
+      }
+    }
+    return JSString::New(ctx, result);
+  }
+  // full case mapping may change length
+  std::vector<uc16> buf(str->size());
+  int32_t len;
+  for (;;) {
+    UErrorCode status = U_ZERO_ERROR;
+    len = kUpper ?
+        u_strToUpper(buf.data(), buf.size(),
+                     str->data(), str->size(), "", &status) :
+        u_strToLower(buf.data(), buf.size(),
+                     str->data(), str->size(), "", &status);
+    if (status != U_BUFFER_OVERFLOW_ERROR) {
+      break;
+    }
+    buf.resize(len);
+  }
+  return JSString::New(ctx, core::UStringPiece(buf.data(), len));
+}
+
 }  // namespace iv::lv5::runtime::detail
 
 // section 15.5.1
@@ -160,9 +226,10 @@ inline JSVal StringIndexOf(const Arguments& args, Error* error) {
   }
   const std::size_t start = std::min(
       static_cast<std::size_t>(std::max(position, 0.0)), str->size());
-  const GCUString::size_type loc =
-      str->value().find(search_str->value(), start);
-  return (loc == GCUString::npos) ? -1.0 : loc;
+  const std::size_t loc =
+      core::StringFind(str->data(), str->size(),
+                       search_str->data(), search_str->size(), start);
+  return (loc == core::StringSearch<uc16>::npos) ? -1.0 : loc;
 }
 
 // section 15.5.4.8 String.prototype.lastIndexOf(searchString, position)
@@ -172,21 +239,224 @@ inline JSVal StringLastIndexOf(const Arguments& args, Error* error) {
   val.CheckObjectCoercible(ERROR(error));
   const JSString* const str = val.ToString(args.ctx(), ERROR(error));
   const JSString* search_str;
-  // undefined -> NaN -> 0
+  // undefined -> NaN -> +Infinity
   std::size_t pos = std::numeric_limits<std::size_t>::max();
   if (args.size() > 0) {
     search_str = args[0].ToString(args.ctx(), ERROR(error));
     if (args.size() > 1) {
       const double position = args[1].ToNumber(args.ctx(), ERROR(error));
-      pos = core::DoubleToUInt32(core::DoubleToInteger(position));
+      if (!std::isnan(position)) {
+        pos = static_cast<std::size_t>(
+            std::min<double>(std::max(core::DoubleToInteger(position), 0.0),
+                             str->size()));
+      }
     }
   } else {
     // undefined -> "undefined"
     search_str = JSString::NewAsciiString(args.ctx(), "undefined");
   }
-  const GCUString::size_type loc =
-      str->value().rfind(search_str->value(), std::min(pos, str->size()));
-  return (loc == GCUString::npos) ? -1.0 : loc;
+  const core::StringSearch<uc16> search(search_str->data(),
+                                        search_str->size());
+  const std::size_t loc = search.ReverseSearch(str->data(), str->size(), pos);
+  return (loc == core::StringSearch<uc16>::npos) ? -1.0 : loc;
+}
+
+// section 15.5.4.11 String.prototype.replace(searchValue, replaceValue)
+// RegExp searchValue is not supported yet, it is converted to string
+inline JSVal StringReplace(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("String.prototype.replace", args, error);
+  Context* const ctx = args.ctx();
+  const JSVal& val = args.this_binding();
+  val.CheckObjectCoercible(ERROR(error));
+  JSString* const str = val.ToString(ctx, ERROR(error));
+  const JSVal search_value =
+      (args.size() > 0) ? args[0] : JSVal(JSUndefined);
+  const JSString* const search_str = search_value.ToString(ctx, ERROR(error));
+  const JSVal replace_value =
+      (args.size() > 1) ? args[1] : JSVal(JSUndefined);
+  const JSString* replace_str = NULL;
+  if (!replace_value.IsCallable()) {
+    replace_str = replace_value.ToString(ctx, ERROR(error));
+  }
+  const std::size_t loc =
+      core::StringFind(str->data(), str->size(),
+                       search_str->data(), search_str->size());
+  if (loc == core::StringSearch<uc16>::npos) {
+    return str;
+  }
+  const std::size_t loc_end = loc + search_str->size();
+  core::UString result(str->data(), loc);
+  if (replace_str) {
+    // replacement patterns of table 22
+    // no captures, so $n and $nn are not replaced
+    result.reserve(str->size() + replace_str->size());
+    for (JSString::const_iterator it = replace_str->begin(),
+         last = replace_str->end(); it != last; ++it) {
+      if (*it == '$' && (it + 1) != last) {
+        const uc16 ch = *(it + 1);
+        if (ch == '$') {
+          result.push_back('$');
+          ++it;
+          continue;
+        } else if (ch == '&') {
+          result.append(search_str->data(), search_str->size());
+          ++it;
+          continue;
+        } else if (ch == '`') {
+          result.append(str->data(), loc);
+          ++it;
+          continue;
+        } else if (ch == '\'') {
+          result.append(str->data() + loc_end, str->size() - loc_end);
+          ++it;
+          continue;
+        }
+      }
+      result.push_back(*it);
+    }
+  } else {
+    Arguments a(ctx, 3);
+    a[0] = JSString::New(ctx,
+                         core::UStringPiece(str->data() + loc,
+                                            search_str->size()));
+    a[1] = static_cast<double>(loc);
+    a[2] = str;
+    const JSVal res =
+        replace_value.object()->AsCallable()->Call(a, ERROR(error));
+    const JSString* const replaced = res.ToString(ctx, ERROR(error));
+    result.append(replaced->data(), replaced->size());
+  }
+  result.append(str->data() + loc_end, str->size() - loc_end);
+  return JSString::New(ctx, result);
+}
+
+// section 15.5.4.13 String.prototype.slice(start, end)
+inline JSVal StringSlice(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("String.prototype.slice", args, error);
+  Context* const ctx = args.ctx();
+  const JSVal& val = args.this_binding();
+  val.CheckObjectCoercible(ERROR(error));
+  JSString* const str = val.ToString(ctx, ERROR(error));
+  const double len = str->size();
+  double start = 0;
+  if (args.size() > 0) {
+    start = args[0].ToNumber(ctx, ERROR(error));
+    start = core::DoubleToInteger(start);
+  }
+  double end = len;
+  if (args.size() > 1 && !args[1].IsUndefined()) {
+    end = args[1].ToNumber(ctx, ERROR(error));
+    end = core::DoubleToInteger(end);
+  }
+  const double from = (start < 0) ?
+      std::max(len + start, 0.0) : std::min(start, len);
+  const double to = (end < 0) ?
+      std::max(len + end, 0.0) : std::min(end, len);
+  return detail::SubString(ctx, str,
+                           static_cast<std::size_t>(from),
+                           static_cast<std::size_t>(std::max(to, from)));
+}
+
+// section 15.5.4.14 String.prototype.split(separator, limit)
+// RegExp separator is not supported yet, it is converted to string
+inline JSVal StringSplit(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("String.prototype.split", args, error);
+  Context* const ctx = args.ctx();
+  const JSVal& val = args.this_binding();
+  val.CheckObjectCoercible(ERROR(error));
+  JSString* const str = val.ToString(ctx, ERROR(error));
+  uint32_t lim = 4294967295UL;
+  if (args.size() > 1 && !args[1].IsUndefined()) {
+    const double limit = args[1].ToNumber(ctx, ERROR(error));
+    lim = core::DoubleToUInt32(limit);
+  }
+  const JSVal separator = (args.size() > 0) ? args[0] : JSVal(JSUndefined);
+  const JSString* const sep =
+      separator.IsUndefined() ? NULL : separator.ToString(ctx, ERROR(error));
+  JSArray::Vector values;
+  if (lim == 0) {
+    return JSArray::New(ctx);
+  }
+  if (!sep) {
+    values.push_back(str);
+    return JSArray::New(ctx, values);
+  }
+  const std::size_t size = str->size();
+  const std::size_t sep_size = sep->size();
+  if (size == 0) {
+    // empty separator matches empty string
+    if (sep_size != 0) {
+      values.push_back(str);
+    }
+    return JSArray::New(ctx, values);
+  }
+  if (sep_size == 0) {
+    // split to characters
+    const std::size_t n = std::min<std::size_t>(size, lim);
+    values.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      values.push_back(
+          JSString::New(ctx, core::UStringPiece(str->data() + i, 1)));
+    }
+    return JSArray::New(ctx, values);
+  }
+  const core::StringSearch<uc16> search(sep->data(), sep_size);
+  std::size_t p = 0;
+  for (std::size_t q = search.Search(str->data(), size, p);
+       q != core::StringSearch<uc16>::npos;
+       q = search.Search(str->data(), size, p)) {
+    values.push_back(detail::SubString(ctx, str, p, q));
+    if (values.size() == lim) {
+      return JSArray::New(ctx, values);
+    }
+    p = q + sep_size;
+  }
+  values.push_back(detail::SubString(ctx, str, p, size));
+  return JSArray::New(ctx, values);
+}
+
+// section 15.5.4.15 String.prototype.substring(start, end)
+inline JSVal StringSubstring(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("String.prototype.substring", args, error);
+  Context* const ctx = args.ctx();
+  const JSVal& val = args.this_binding();
+  val.CheckObjectCoercible(ERROR(error));
+  JSString* const str = val.ToString(ctx, ERROR(error));
+  const double len = str->size();
+  double start = 0;
+  if (args.size() > 0) {
+    start = args[0].ToNumber(ctx, ERROR(error));
+    start = core::DoubleToInteger(start);
+  }
+  double end = len;
+  if (args.size() > 1 && !args[1].IsUndefined()) {
+    end = args[1].ToNumber(ctx, ERROR(error));
+    end = core::DoubleToInteger(end);
+  }
+  const double final_start = std::min(std::max(start, 0.0), len);
+  const double final_end = std::min(std::max(end, 0.0), len);
+  return detail::SubString(
+      ctx, str,
+      static_cast<std::size_t>(std::min(final_start, final_end)),
+      static_cast<std::size_t>(std::max(final_start, final_end)));
+}
+
+// section 15.5.4.16 String.prototype.toLowerCase()
+inline JSVal StringToLowerCase(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("String.prototype.toLowerCase", args, error);
+  const JSVal& val = args.this_binding();
+  val.CheckObjectCoercible(ERROR(error));
+  JSString* const str = val.ToString(args.ctx(), ERROR(error));
+  return detail::ConvertCase<false>(args.ctx(), str);
+}
+
+// section 15.5.4.18 String.prototype.toUpperCase()
+inline JSVal StringToUpperCase(const Arguments& args, Error* error) {
+  CONSTRUCTOR_CHECK("String.prototype.toUpperCase", args, error);
+  const JSVal& val = args.this_binding();
+  val.CheckObjectCoercible(ERROR(error));
+  JSString* const str = val.ToString(args.ctx(), ERROR(error));
+  return detail::ConvertCase<true>(args.ctx(), str);
 }
 
 } } }  // namespace iv::lv5::runtime
@@ -0,0 +1,55 @@
+#ifndef _IV_LV5_STACK_H_
+#define _IV_LV5_STACK_H_
+#include <cstddef>
+#include <cassert>
+#include <gc/gc.h>
+#include "jsval.h"
+#include "noncopyable.h"
+namespace iv {
+namespace lv5 {
+
+// VM stack
+// contiguous JSVal region shared by calls in LIFO order.
+// region is allocated by GC_MALLOC_UNCOLLECTABLE,
+// so values on this stack are scanned as GC roots.
+class Stack : private core::Noncopyable<Stack>::type {
+ public:
+  static const std::size_t kStackCapacity = 16 * 1024;
+
+  Stack()
+    : stack_(static_cast<JSVal*>(
+        GC_MALLOC_UNCOLLECTABLE(kStackCapacity * sizeof(JSVal)))),
+      stack_pointer_(stack_) {
+  }
+
+  ~Stack() {
+    GC_FREE(stack_);
+  }
+
+  // returns NULL if stack is exhausted
+  inline JSVal* Gain(std::size_t n) {
+    if (n > static_cast<std::size_t>((stack_ + kStackCapacity) -
+                                     stack_pointer_)) {
+      return NULL;
+    }
+    JSVal* const base = stack_pointer_;
+    stack_pointer_ += n;
+    return base;
+  }
+
+  inline void Release(std::size_t n) {
+    assert(stack_ + n <= stack_pointer_);
+    stack_pointer_ -= n;
+  }
+
+  inline std::size_t size() const {
+    return stack_pointer_ - stack_;
+  }
+
+ private:
+  JSVal* stack_;
+  JSVal* stack_pointer_;
+};
+
+} }  // namespace iv::lv5
+#endif  // _IV_LV5_STACK_H_
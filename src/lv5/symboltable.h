@@ -5,22 +5,42 @@
 #include <tr1/unordered_map>
 #include <boost/thread.hpp>
 #include <boost/foreach.hpp>
-#include "jsstring.h"
+#include "alloc.h"
+#include "noncopyable.h"
 #include "symbol.h"
 #include "ustring.h"
 #include "conversions.h"
 namespace iv {
 namespace lv5 {
-class Context;
-class SymbolTable {
+
+// symbol table shared by Contexts which run the same AST.
+// (see CompiledScript) Context owns its table by default.
+//
+// strings are stored in fixed size chunks, which are never moved,
+// so GetContent reads without lock while other threads intern.
+// number of symbols is bounded by kMaxSymbols, exceeding it is
+// handled as out of memory.
+class SymbolTable : private core::Noncopyable<SymbolTable>::type {
  public:
-  typedef std::vector<core::UString> Strings;
   typedef std::vector<std::size_t> Indexes;
   typedef std::tr1::unordered_map<std::size_t, Indexes> Table;
+  static const std::size_t kChunkBits = 12;
+  static const std::size_t kChunkSize = 1 << kChunkBits;
+  static const std::size_t kMaxChunks = 4096;
+  static const std::size_t kMaxSymbols = kChunkSize * kMaxChunks;
+
   SymbolTable()
     : sync_(),
       table_(),
-      strings_() {
+      chunks_(new core::UString*[kMaxChunks]()),
+      size_(0) {
+  }
+
+  ~SymbolTable() {
+    for (std::size_t i = 0; i < kMaxChunks && chunks_[i]; ++i) {
+      delete[] chunks_[i];
+    }
+    delete[] chunks_;
   }
 
   template<class CharT>
@@ -31,45 +51,77 @@ class SymbolTable {
 
   template<class String>
   inline Symbol Lookup(const String& str) {
-    std::size_t hash = StringToHash(str);
+    std::size_t hash = core::StringToHash(str);
     core::UString target(str.begin(), str.end());
     {
       boost::mutex::scoped_lock lock(sync_);
       Table::iterator it = table_.find(hash);
       if (it == table_.end()) {
-        Symbol sym = strings_.size();
-        strings_.push_back(target);
+        const Symbol sym = Add(&target);
         Indexes vec(1, sym);
         table_.insert(it, make_pair(hash, vec));
         return sym;
       } else {
         Indexes& vec = it->second;
         BOOST_FOREACH(const std::size_t& i, vec) {
-          if (strings_[i] == target) {
+          if (GetContent(i) == target) {
             return i;
           }
         }
-        Symbol sym = strings_.size();
-        strings_.push_back(target);
+        const Symbol sym = Add(&target);
         vec.push_back(sym);
         return sym;
       }
     }
   }
 
-  inline JSString* ToString(Context* ctx, Symbol sym) const {
-    const core::UString& str = strings_[sym];
-    return JSString::New(ctx, str);
+  // lookup without interning, returns false if str is not a symbol yet
+  template<class String>
+  inline bool Find(const String& str, Symbol* sym) const {
+    std::size_t hash = core::StringToHash(str);
+    core::UString target(str.begin(), str.end());
+    boost::mutex::scoped_lock lock(sync_);
+    Table::const_iterator it = table_.find(hash);
+    if (it != table_.end()) {
+      BOOST_FOREACH(const std::size_t& i, it->second) {
+        if (GetContent(i) == target) {
+          *sym = i;
+          return true;
+        }
+      }
+    }
+    return false;
   }
 
+  // sym is a result of Lookup, so its slot is already filled
   inline const core::UString& GetContent(Symbol sym) const {
-    return strings_[sym];
+    return chunks_[sym >> kChunkBits][sym & (kChunkSize - 1)];
+  }
+
+  inline std::size_t size() const {
+    return size_;
   }
 
  private:
-  boost::mutex sync_;
+  // called with lock
+  Symbol Add(core::UString* str) {
+    const Symbol sym = size_;
+    const std::size_t chunk = sym >> kChunkBits;
+    if (chunk == kMaxChunks) {
+      core::Malloced::OutOfMemory();
+    }
+    if (!chunks_[chunk]) {
+      chunks_[chunk] = new core::UString[kChunkSize];
+    }
+    chunks_[chunk][sym & (kChunkSize - 1)].swap(*str);
+    ++size_;
+    return sym;
+  }
+
+  mutable boost::mutex sync_;
   Table table_;
-  Strings strings_;
+  core::UString** chunks_;
+  std::size_t size_;
 };
 } }  // namespace iv::lv5
 #endif  // _IV_LV5_SYMBOLTABLE_H_
@@ -283,8 +283,8 @@ class Parser : private Noncopyable<Parser<Factory, Source> >::type {
             stmt->AsExpressionStatement()) {
           Expression* const expr = stmt->AsExpressionStatement()->expr();
           if (expr->AsDirectivable()) {
-            if (expr->AsStringLiteral()->value().compare(
-                    ParserData::kUseStrict.data()) == 0) {
+            if (expr->AsStringLiteral()->value() ==
+                UStringPiece(ParserData::kUseStrict)) {
               switcher.SwitchStrictMode();
               function->set_strict(true);
             }
@@ -578,6 +578,7 @@ class Parser : private Noncopyable<Parser<Factory, Source> >::type {
   Statement* ParseDoWhileStatement(bool *res) {
     //  DO Statement WHILE '(' Expression ')' ';'
     assert(token_ == Token::DO);
+    const std::size_t line_number = lexer_.line_number();
     Target target(this, Target::kIterationStatement);
     Next();
 
@@ -600,6 +601,7 @@ class Parser : private Noncopyable<Parser<Factory, Source> >::type {
       Next();
     }
     DoWhileStatement* const dowhile = factory_->NewDoWhileStatement(stmt, expr);
+    dowhile->set_line_number(line_number);
     target.set_node(dowhile);
     return dowhile;
   }
@@ -607,6 +609,7 @@ class Parser : private Noncopyable<Parser<Factory, Source> >::type {
 //  WHILE '(' Expression ')' Statement
   Statement* ParseWhileStatement(bool *res) {
     assert(token_ == Token::WHILE);
+    const std::size_t line_number = lexer_.line_number();
     Next();
 
     EXPECT(Token::LPAREN);
@@ -618,6 +621,7 @@ class Parser : private Noncopyable<Parser<Factory, Source> >::type {
 
     Statement* const stmt = ParseStatement(CHECK);
     WhileStatement* const whilestmt = factory_->NewWhileStatement(stmt, expr);
+    whilestmt->set_line_number(line_number);
 
     target.set_node(whilestmt);
     return whilestmt;
@@ -633,6 +637,7 @@ class Parser : private Noncopyable<Parser<Factory, Source> >::type {
 //  FOR '(' VAR VariableDeclarationNoIn IN Expression ')' Statement
   Statement* ParseForStatement(bool *res) {
     assert(token_ == Token::FOR);
+    const std::size_t line_number = lexer_.line_number();
     Next();
 
     EXPECT(Token::LPAREN);
@@ -659,6 +664,7 @@ class Parser : private Noncopyable<Parser<Factory, Source> >::type {
           Statement* const body = ParseStatement(CHECK);
           ForInStatement* const forstmt =
               factory_->NewForInStatement(body, init, enumerable);
+          forstmt->set_line_number(line_number);
           target.set_node(forstmt);
           return forstmt;
         }
@@ -677,6 +683,7 @@ class Parser : private Noncopyable<Parser<Factory, Source> >::type {
           Statement* const body = ParseStatement(CHECK);
           ForInStatement* const forstmt =
               factory_->NewForInStatement(body, init, enumerable);
+          forstmt->set_line_number(line_number);
           target.set_node(forstmt);
           return forstmt;
         }
@@ -708,6 +715,7 @@ class Parser : private Noncopyable<Parser<Factory, Source> >::type {
     Statement* const body = ParseStatement(CHECK);
     ForStatement* const forstmt =
         factory_->NewForStatement(body, init, cond, next);
+    forstmt->set_line_number(line_number);
     target.set_node(forstmt);
     return forstmt;
   }
@@ -1532,9 +1540,14 @@ class Parser : private Noncopyable<Parser<Factory, Source> >::type {
         Next();
         break;
 
-      case Token::IDENTIFIER:
-        result = ParseIdentifier(lexer_.Buffer());
+      case Token::IDENTIFIER: {
+        Identifier* const ident = ParseIdentifier(lexer_.Buffer());
+        if (IsEvalOrArguments(ident)) {
+          scope_->set_needs_arguments(true);
+        }
+        result = ident;
         break;
+      }
 
       case Token::NULL_LITERAL:
         result = factory_->NewNullLiteral();
@@ -2183,10 +2196,10 @@ class Parser : private Noncopyable<Parser<Factory, Source> >::type {
   };
 
   static EvalOrArguments IsEvalOrArguments(const Identifier* ident) {
-    const SpaceUString& str = ident->value();
-    if (str.compare(ParserData::kEval.data()) == 0) {
+    const UStringPiece& str = ident->value();
+    if (str == UStringPiece(ParserData::kEval)) {
       return kEval;
-    } else if (str.compare(ParserData::kArguments.data()) == 0) {
+    } else if (str == UStringPiece(ParserData::kArguments)) {
       return kArguments;
     } else {
       return kNone;
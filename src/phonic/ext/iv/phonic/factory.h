@@ -15,14 +15,15 @@ namespace phonic {
 class AstFactory : public core::Space<2> {
  public:
   AstFactory()
-    : core::Space<2>(),
-      undefined_instance_(new(this)Undefined()),
-      empty_statement_instance_(new(this)EmptyStatement()),
-      debugger_statement_instance_(new(this)DebuggerStatement()),
-      this_instance_(new(this)ThisLiteral()),
-      null_instance_(new(this)NullLiteral()),
-      true_instance_(new(this)TrueLiteral()),
-      false_instance_(new(this)FalseLiteral()) {
+    : core::Space<2>() {
+    CreateInstances();
+  }
+
+  // drop all AST and rewind space, so that this factory can be reused
+  // for the next parse
+  void Clear() {
+    core::Space<2>::Clear();
+    CreateInstances();
   }
 
   template<typename Range>
@@ -257,6 +258,16 @@ class AstFactory : public core::Space<2> {
   }
 
  private:
+  void CreateInstances() {
+    undefined_instance_ = new(this)Undefined();
+    empty_statement_instance_ = new(this)EmptyStatement();
+    debugger_statement_instance_ = new(this)DebuggerStatement();
+    this_instance_ = new(this)ThisLiteral();
+    null_instance_ = new(this)NullLiteral();
+    true_instance_ = new(this)TrueLiteral();
+    false_instance_ = new(this)FalseLiteral();
+  }
+
   Undefined* undefined_instance_;
   EmptyStatement* empty_statement_instance_;
   DebuggerStatement* debugger_statement_instance_;
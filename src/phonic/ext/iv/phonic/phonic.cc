@@ -18,7 +18,10 @@ namespace phonic {
 static VALUE cParseError;
 
 static VALUE Parse(VALUE self, VALUE rb_str) {
-  AstFactory factory;
+  // one factory is reused by every parse. rb_raise does not unwind C++
+  // frames, so a local factory would also leak its space on ParseError
+  static AstFactory factory;
+  factory.Clear();
   Check_Type(rb_str, T_STRING);
   VALUE encoded_rb_str = rb_str_encode(rb_str,
                                        Encoding::UTF16Encoding(),
@@ -13,6 +13,7 @@
 #include <tr1/unordered_map>
 #include <tr1/functional>
 #include "uchar.h"
+#include "ustringpiece.h"
 #include "conversions.h"
 
 namespace iv {
@@ -154,6 +155,22 @@ struct SpaceUString {
                             SpaceAllocator<Factory, uc16> > type;
 };
 
+// copy [it, last) into factory space as flat uc16 array.
+// returned range is valid while factory is alive and has no string header,
+// so AST nodes hold 2 words per string instead of a whole basic_string
+template<typename Factory, typename Iter>
+inline UStringPiece NewSpaceUStringPiece(Factory* factory,
+                                         Iter it, Iter last) {
+  const std::size_t size = std::distance(it, last);
+  if (size == 0) {
+    return UStringPiece();
+  }
+  uc16* const ptr =
+      reinterpret_cast<uc16*>(factory->New(size * sizeof(uc16)));
+  std::copy(it, last, ptr);
+  return UStringPiece(ptr, size);
+}
+
 } }  // namespace iv::core
 namespace std {
 namespace tr1 {
@@ -0,0 +1,256 @@
+#ifndef _IV_STRING_SEARCH_H_
+#define _IV_STRING_SEARCH_H_
+#include <cstddef>
+#include <algorithm>
+#include <tr1/array>
+namespace iv {
+namespace core {
+
+// substring search for fixed pattern
+//
+// strategy is chosen by pattern length.
+//   short pattern: scan first character, and compare rest
+//   long pattern:  Boyer-Moore-Horspool
+// Horspool is O(nm) in the worst case, so if it compares too many
+// characters, search is continued by Two-Way algorithm,
+// which is linear time and constant space.
+//
+// pattern is not copied, so it must outlive StringSearch
+template<typename Char>
+class StringSearch {
+ public:
+  static const std::size_t npos = static_cast<std::size_t>(-1);
+  static const std::size_t kHorspoolThreshold = 8;
+  static const std::size_t kTableSize = 256;
+
+  StringSearch(const Char* pattern, std::size_t size)
+    : pattern_(pattern),
+      size_(size) {
+    // table is used only by Horspool
+    if (size_ >= kHorspoolThreshold) {
+      // characters are hashed by lower 8 bits.
+      // table is filled from front, so collided characters have
+      // minimum shift of them, and it is always safe
+      table_.assign(size_);
+      for (std::size_t i = 0, last = size_ - 1; i < last; ++i) {
+        table_[Hash(pattern_[i])] = last - i;
+      }
+    }
+  }
+
+  // returns first index of pattern in subject, which is >= start
+  std::size_t Search(const Char* subject, std::size_t size,
+                     std::size_t start = 0) const {
+    if (start > size || size - start < size_) {
+      return npos;
+    }
+    if (size_ == 0) {
+      return start;
+    }
+    if (size_ < kHorspoolThreshold) {
+      return FirstCharSearch(subject, size, start);
+    }
+    return HorspoolSearch(subject, size, start);
+  }
+
+  // returns last index of pattern in subject, which is <= start
+  std::size_t ReverseSearch(const Char* subject, std::size_t size,
+                            std::size_t start = npos) const {
+    if (size < size_) {
+      return npos;
+    }
+    std::size_t pos = std::min(start, size - size_);
+    if (size_ == 0) {
+      return pos;
+    }
+    const Char first = pattern_[0];
+    for (;; --pos) {
+      if (subject[pos] == first &&
+          std::equal(pattern_ + 1, pattern_ + size_, subject + pos + 1)) {
+        return pos;
+      }
+      if (pos == 0) {
+        return npos;
+      }
+    }
+  }
+
+ private:
+  static std::size_t Hash(Char ch) {
+    return static_cast<std::size_t>(ch) & (kTableSize - 1);
+  }
+
+  std::size_t FirstCharSearch(const Char* subject, std::size_t size,
+                              std::size_t start) const {
+    const Char first = pattern_[0];
+    const Char* const last = subject + (size - size_ + 1);
+    for (const Char* it = subject + start; ; ++it) {
+      it = std::find(it, last, first);
+      if (it == last) {
+        return npos;
+      }
+      if (std::equal(pattern_ + 1, pattern_ + size_, it + 1)) {
+        return it - subject;
+      }
+    }
+  }
+
+  std::size_t HorspoolSearch(const Char* subject, std::size_t size,
+                             std::size_t start) const {
+    const std::size_t last_index = size_ - 1;
+    const Char last_char = pattern_[last_index];
+    // characters compared beyond this budget switch to Two-Way
+    std::size_t budget = 4 * size_ + 64;
+    std::size_t pos = start;
+    while (pos <= size - size_) {
+      const Char ch = subject[pos + last_index];
+      if (ch == last_char) {
+        std::size_t i = 0;
+        while (i < last_index && pattern_[i] == subject[pos + i]) {
+          ++i;
+        }
+        if (i == last_index) {
+          return pos;
+        }
+        if (budget <= i) {
+          return TwoWaySearch(subject, size, pos);
+        }
+        budget -= i;
+      }
+      const std::size_t shift = table_[Hash(ch)];
+      pos += shift;
+      budget += shift;
+    }
+    return npos;
+  }
+
+  // Crochemore-Perrin Two-Way algorithm
+  // returns the critical position and stores period of pattern
+  std::size_t CriticalFactorization(std::size_t* period) const {
+    std::size_t max_suffix, max_suffix_rev, j, k, p;
+
+    // maximal suffix for <
+    max_suffix = npos;
+    j = 0;
+    k = p = 1;
+    while (j + k < size_) {
+      const Char a = pattern_[j + k];
+      const Char b = pattern_[max_suffix + k];
+      if (a < b) {
+        j += k;
+        k = 1;
+        p = j - max_suffix;
+      } else if (a == b) {
+        if (k != p) {
+          ++k;
+        } else {
+          j += p;
+          k = 1;
+        }
+      } else {
+        max_suffix = j++;
+        k = p = 1;
+      }
+    }
+    *period = p;
+
+    // maximal suffix for >
+    max_suffix_rev = npos;
+    j = 0;
+    k = p = 1;
+    while (j + k < size_) {
+      const Char a = pattern_[j + k];
+      const Char b = pattern_[max_suffix_rev + k];
+      if (b < a) {
+        j += k;
+        k = 1;
+        p = j - max_suffix_rev;
+      } else if (a == b) {
+        if (k != p) {
+          ++k;
+        } else {
+          j += p;
+          k = 1;
+        }
+      } else {
+        max_suffix_rev = j++;
+        k = p = 1;
+      }
+    }
+
+    // npos + 1 is 0
+    if (max_suffix_rev + 1 < max_suffix + 1) {
+      return max_suffix + 1;
+    }
+    *period = p;
+    return max_suffix_rev + 1;
+  }
+
+  std::size_t TwoWaySearch(const Char* subject, std::size_t size,
+                           std::size_t start) const {
+    std::size_t period;
+    const std::size_t suffix = CriticalFactorization(&period);
+    std::size_t pos = start;
+    if (std::equal(pattern_, pattern_ + suffix, pattern_ + period)) {
+      // periodic pattern, matched prefix is remembered
+      std::size_t memory = 0;
+      while (pos <= size - size_) {
+        std::size_t i = std::max(suffix, memory);
+        while (i < size_ && pattern_[i] == subject[pos + i]) {
+          ++i;
+        }
+        if (size_ <= i) {
+          i = suffix - 1;
+          while (memory < i + 1 && pattern_[i] == subject[pos + i]) {
+            --i;
+          }
+          if (i + 1 < memory + 1) {
+            return pos;
+          }
+          pos += period;
+          memory = size_ - period;
+        } else {
+          pos += i - suffix + 1;
+          memory = 0;
+        }
+      }
+    } else {
+      const std::size_t shift = std::max(suffix, size_ - suffix) + 1;
+      while (pos <= size - size_) {
+        std::size_t i = suffix;
+        while (i < size_ && pattern_[i] == subject[pos + i]) {
+          ++i;
+        }
+        if (size_ <= i) {
+          i = suffix - 1;
+          while (i != npos && pattern_[i] == subject[pos + i]) {
+            --i;
+          }
+          if (i == npos) {
+            return pos;
+          }
+          pos += shift;
+        } else {
+          pos += i - suffix + 1;
+        }
+      }
+    }
+    return npos;
+  }
+
+  const Char* pattern_;
+  std::size_t size_;
+  std::tr1::array<std::size_t, kTableSize> table_;
+};
+
+template<typename Char>
+inline std::size_t StringFind(const Char* subject, std::size_t subject_size,
+                              const Char* pattern, std::size_t pattern_size,
+                              std::size_t start = 0) {
+  return StringSearch<Char>(pattern, pattern_size).Search(subject,
+                                                          subject_size,
+                                                          start);
+}
+
+} }  // namespace iv::core
+#endif  // _IV_STRING_SEARCH_H_
@@ -317,7 +317,7 @@ class BasicStringPiece {
   }
 
   static int wordmemcmp(const CharT * p, const CharT * p2, size_type N) {
-    return memcmp(p, p2, N);
+    return Traits::compare(p, p2, N);
   }
 
   static inline void BuildLookupTable(const this_type& characters_wanted,
@@ -0,0 +1,8 @@
+#include <gtest/gtest.h>
+#include "fpu.h"
+
+int main(int argc, char **argv) {
+  iv::lv5::FixFPU();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <ctime>
+#include "test_lv5.h"
+
+using iv::lv5::test::Evaluate;
+
+namespace {
+
+// burns CPU time on its own thread
+void* Spin(void* arg) {
+  const std::clock_t* const duration = static_cast<std::clock_t*>(arg);
+  const std::clock_t start = std::clock();
+  volatile uint64_t count = 0;
+  while (std::clock() - start < *duration) {
+    ++count;
+  }
+  return NULL;
+}
+
+}  // namespace anonymous
+
+TEST(ExecutionBudgetCase, TickLimitTest) {
+  iv::lv5::Context ctx;
+  ctx.budget()->set_tick_limit(10000);
+  ctx.budget()->Start();
+  EXPECT_EQ("RangeError: execution budget exceeded",
+            Evaluate(&ctx, "while (true) { }"));
+  // stopped until Start is called
+  EXPECT_EQ("RangeError: execution budget exceeded",
+            Evaluate(&ctx, "for (var i = 0; i < 10; ++i) { } i"));
+  ctx.budget()->Start();
+  EXPECT_EQ("10", Evaluate(&ctx, "for (var i = 0; i < 10; ++i) { } i"));
+}
+
+TEST(ExecutionBudgetCase, TimeLimitTest) {
+  iv::lv5::Context ctx;
+  ctx.budget()->set_time_limit(50);
+  ctx.budget()->Start();
+  EXPECT_EQ("RangeError: execution budget exceeded",
+            Evaluate(&ctx, "while (true) { }"));
+}
+
+TEST(ExecutionBudgetCase, ThreadTimeTest) {
+  // CPU time of other threads is not charged to this Context
+  iv::lv5::Context ctx;
+  ctx.budget()->set_time_limit(100);
+  ctx.budget()->Start();
+  std::clock_t duration = CLOCKS_PER_SEC * 3 / 10;
+  pthread_t thread;
+  ASSERT_EQ(0, pthread_create(&thread, NULL, &Spin, &duration));
+  ASSERT_EQ(0, pthread_join(thread, NULL));
+  EXPECT_EQ("5000",
+            Evaluate(&ctx, "for (var i = 0; i < 5000; ++i) { } i"));
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "test_lv5.h"
+
+using iv::lv5::test::Evaluate;
+
+TEST(CaptureAnalyzerCase, CapturedVariableTest) {
+  iv::lv5::Context ctx;
+  EXPECT_EQ("1",
+            Evaluate(&ctx,
+                     "function f() { var x = 1;"
+                     "  return function() { return x; }; }"
+                     "f()();"));
+  EXPECT_EQ("3",
+            Evaluate(&ctx,
+                     "function g(a, b) { var c = 0;"
+                     "  return function() { return a + b + c; }; }"
+                     "g(1, 2)();"));
+}
+
+TEST(CaptureAnalyzerCase, FunctionNameTest) {
+  iv::lv5::Context ctx;
+  // name of declaration is binding of enclosing function
+  EXPECT_EQ("ok",
+            Evaluate(&ctx,
+                     "function f() {"
+                     "  function h(n) { return n ? h(n - 1) : 'ok'; }"
+                     "  return h; }"
+                     "f()(3);"));
+  // name of named function expression is its own binding
+  EXPECT_EQ("fe",
+            Evaluate(&ctx,
+                     "function k() {"
+                     "  return function fe(n) {"
+                     "    return n ? fe(n - 1) : 'fe'; }; }"
+                     "k()(3);"));
+}
+
+TEST(CaptureAnalyzerCase, ArgumentsTest) {
+  iv::lv5::Context ctx;
+  EXPECT_EQ("2",
+            Evaluate(&ctx,
+                     "function f(a) {"
+                     "  return function() { return arguments.length; }; }"
+                     "f(1)(1, 2);"));
+  EXPECT_EQ("5",
+            Evaluate(&ctx,
+                     "function f(a) { var args = arguments;"
+                     "  return function() { args[0] = 5; return a; }; }"
+                     "f(1)();"));
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "compiled_script.h"
+#include "symboltable.h"
+#include "test_lv5.h"
+
+using iv::lv5::test::Evaluate;
+using iv::lv5::test::RunScript;
+
+TEST(CompiledScriptCase, InstantiateTest) {
+  iv::lv5::SymbolTable table;
+  iv::lv5::Context ctx1(&table);
+  iv::lv5::Context ctx2(&table);
+  std::string error;
+  iv::lv5::CompiledScript* const script = iv::lv5::CompiledScript::New(
+      &ctx1,
+      "var count = (typeof count === 'undefined') ? 1 : count + 1;"
+      "var obj = { name: 'obj' }, ary = [count];"
+      "function f(n) { return n ? f(n - 1) + 1 : 0; }"
+      "switch (obj.name) { case 'obj': obj.found = true; }"
+      "obj.name + ary[0] + f(3) + obj.found;",
+      "test", &error);
+  ASSERT_TRUE(script) << error;
+  EXPECT_EQ(&table, script->symbol_table());
+  // globals of each Context are independent
+  EXPECT_EQ("obj13true", RunScript(&ctx1, script->Instantiate(&ctx1)));
+  EXPECT_EQ("obj23true", RunScript(&ctx1, script->Instantiate(&ctx1)));
+  EXPECT_EQ("obj13true", RunScript(&ctx2, script->Instantiate(&ctx2)));
+  // names defined by compiled script are usable from other scripts
+  EXPECT_EQ("3", Evaluate(&ctx2, "f(3);"));
+  delete script;
+}
+
+TEST(CompiledScriptCase, ErrorTest) {
+  iv::lv5::Context ctx;
+  std::string error;
+  EXPECT_FALSE(iv::lv5::CompiledScript::New(&ctx, "var;", "test", &error));
+  EXPECT_FALSE(error.empty());
+}
+
+TEST(SymbolTableCase, LookupTest) {
+  iv::lv5::SymbolTable table;
+  const iv::lv5::Symbol a = table.Lookup("a");
+  const iv::lv5::Symbol b = table.Lookup("b");
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a, table.Lookup("a"));
+  EXPECT_EQ(2u, table.size());
+  iv::lv5::Symbol sym;
+  EXPECT_TRUE(table.Find(iv::core::StringPiece("b"), &sym));
+  EXPECT_EQ(b, sym);
+  EXPECT_FALSE(table.Find(iv::core::StringPiece("c"), &sym));
+  EXPECT_EQ(2u, table.size());
+}
+
+TEST(SymbolTableCase, StableContentTest) {
+  // content is not moved when table grows over chunks
+  iv::lv5::SymbolTable table;
+  const iv::lv5::Symbol first = table.Lookup("first");
+  const iv::core::UString* const content = &table.GetContent(first);
+  char buf[32];
+  for (std::size_t i = 0; i < iv::lv5::SymbolTable::kChunkSize * 3; ++i) {
+    std::snprintf(buf, sizeof(buf), "name%lu",
+                  static_cast<unsigned long>(i));  // NOLINT
+    const iv::lv5::Symbol sym = table.Lookup(iv::core::StringPiece(buf));
+    const iv::core::UString& str = table.GetContent(sym);
+    EXPECT_EQ(std::string(buf), std::string(str.begin(), str.end()));
+  }
+  EXPECT_EQ(content, &table.GetContent(first));
+  EXPECT_EQ(std::string("first"),
+            std::string(content->begin(), content->end()));
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "eval_cache.h"
+#include "test_lv5.h"
+
+using iv::lv5::test::Evaluate;
+
+TEST(EvalCacheCase, HitTest) {
+  iv::lv5::Context ctx;
+  iv::lv5::EvalCache* const cache = ctx.eval_cache();
+  EXPECT_EQ("10",
+            Evaluate(&ctx,
+                     "var s = 0;"
+                     "for (var i = 0; i < 10; ++i) { s += eval('1'); }"
+                     "s"));
+  EXPECT_EQ(1u, cache->misses());
+  EXPECT_EQ(9u, cache->hits());
+  // each entry is charged for its factory, not only for its source
+  EXPECT_LT(sizeof(iv::lv5::AstFactory), cache->size());
+}
+
+TEST(EvalCacheCase, CapacityTest) {
+  iv::lv5::Context ctx;
+  iv::lv5::EvalCache* const cache = ctx.eval_cache();
+  // room for 2 short entries
+  cache->set_capacity(sizeof(iv::lv5::AstFactory) * 2 + 1024);
+  EXPECT_EQ("1000",
+            Evaluate(&ctx,
+                     "var s = 0;"
+                     "for (var i = 0; i < 1000; ++i) { s += eval('1;' + i); }"
+                     "s - 499500 + 1000"));
+  EXPECT_EQ(1000u, cache->misses());
+  EXPECT_GE(cache->capacity(), cache->size());
+  EXPECT_EQ("1",
+            Evaluate(&ctx, "eval('1;999') - 998"));
+  EXPECT_EQ(1u, cache->hits());
+  EXPECT_EQ("1",
+            Evaluate(&ctx, "eval('1;0') + 1"));
+  EXPECT_EQ(1001u, cache->misses());
+
+  // entries larger than capacity are not cached
+  cache->set_capacity(1024);
+  EXPECT_EQ(0u, cache->size());
+  EXPECT_EQ("1", Evaluate(&ctx, "eval('1')"));
+  EXPECT_EQ(0u, cache->size());
+}
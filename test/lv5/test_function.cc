@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "test_lv5.h"
+
+using iv::lv5::test::Evaluate;
+
+TEST(JSCodeFunctionCase, LazyPropertyTest) {
+  iv::lv5::Context ctx;
+  EXPECT_EQ("object 2",
+            Evaluate(&ctx,
+                     "function f(a, b) { }"
+                     "typeof f.prototype + ' ' + f.length"));
+  EXPECT_EQ("true", Evaluate(&ctx, "f.prototype.constructor === f"));
+}
+
+TEST(JSCodeFunctionCase, NotExtensibleTest) {
+  iv::lv5::Context ctx;
+  // lazy properties are materialized after extensible flag is cleared
+  EXPECT_EQ("object 2 true",
+            Evaluate(&ctx,
+                     "function f(a, b) { }"
+                     "Object.preventExtensions(f);"
+                     "typeof f.prototype + ' ' + f.length + ' ' +"
+                     "(Object.getPrototypeOf(new f()) === f.prototype)"));
+  EXPECT_EQ("object 1 false",
+            Evaluate(&ctx,
+                     "function g(a) { }"
+                     "Object.freeze(g);"
+                     "g.prototype = null;"
+                     "typeof g.prototype + ' ' + g.length + ' ' +"
+                     "Object.getOwnPropertyDescriptor(g, 'prototype')"
+                     ".writable"));
+  EXPECT_EQ("object 3 false",
+            Evaluate(&ctx,
+                     "function h(a, b, c) { }"
+                     "Object.seal(h);"
+                     "typeof h.prototype + ' ' + h.length + ' ' +"
+                     "Object.getOwnPropertyDescriptor(h, 'prototype')"
+                     ".configurable"));
+  EXPECT_EQ("TypeError",
+            Evaluate(&ctx,
+                     "var s = (function() { 'use strict';"
+                     "  return function() { }; })();"
+                     "Object.preventExtensions(s);"
+                     "try { s.caller; } catch (e) { e.name }"));
+}
@@ -0,0 +1,26 @@
+#include <gtest/gtest.h>
+#include "test_lv5.h"
+
+using iv::lv5::test::Evaluate;
+
+TEST(IndexCase, StringTest) {
+  iv::lv5::Context ctx;
+  EXPECT_EQ("a", Evaluate(&ctx, "'abc'[0]"));
+  EXPECT_EQ("b", Evaluate(&ctx, "'abc'[1]"));
+  EXPECT_EQ("c", Evaluate(&ctx, "'abc'[2]"));
+  EXPECT_EQ("undefined", Evaluate(&ctx, "'abc'[3]"));
+  EXPECT_EQ("undefined", Evaluate(&ctx, "'abc'['01']"));
+  EXPECT_EQ("a", Evaluate(&ctx, "'abc'['0']"));
+  EXPECT_EQ("hello",
+            Evaluate(&ctx,
+                     "var s = 'hello', out = '';"
+                     "for (var i = 0; i < s.length; i++) { out += s[i]; }"
+                     "out"));
+}
+
+TEST(IndexCase, ArrayTest) {
+  iv::lv5::Context ctx;
+  // index 0 updates length of array
+  EXPECT_EQ("1", Evaluate(&ctx, "var a = []; a[0] = 1; a.length"));
+  EXPECT_EQ("0", Evaluate(&ctx, "var b = []; b['01'] = 1; b.length"));
+}
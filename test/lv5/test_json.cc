@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+#include "test_lv5.h"
+
+using iv::lv5::test::Evaluate;
+
+TEST(JSONCase, StringifyTest) {
+  iv::lv5::Context ctx;
+  EXPECT_EQ("[1,\"a\",{\"b\":null}]",
+            Evaluate(&ctx, "JSON.stringify([1, 'a', { b: null }])"));
+  EXPECT_EQ("TypeError: JSON.stringify: cyclic structure",
+            Evaluate(&ctx, "var a = []; a.push(a); JSON.stringify(a)"));
+}
+
+TEST(JSONCase, DepthTest) {
+  iv::lv5::Context ctx;
+  EXPECT_EQ("true",
+            Evaluate(&ctx,
+                     "var a = [];"
+                     "for (var i = 1; i < 4096; ++i) { a = [a]; }"
+                     "JSON.stringify(a).length === 4096 * 2"));
+  EXPECT_EQ("RangeError: JSON.stringify: nesting too deep",
+            Evaluate(&ctx, "JSON.stringify([a])"));
+  EXPECT_EQ("RangeError: JSON.stringify: nesting too deep",
+            Evaluate(&ctx,
+                     "var o = {};"
+                     "for (var i = 0; i < 200000; ++i) { o = { o: [o] }; }"
+                     "JSON.stringify(o)"));
+  EXPECT_EQ("RangeError: JSON.parse: nesting too deep",
+            Evaluate(&ctx,
+                     "var s = '';"
+                     "for (var i = 0; i < 5000; ++i) { s += '['; }"
+                     "JSON.parse(s)"));
+}
@@ -0,0 +1,59 @@
+#ifndef _IV_TEST_LV5_TEST_LV5_H_
+#define _IV_TEST_LV5_TEST_LV5_H_
+#include <string>
+#include <sstream>
+#include <tr1/memory>
+#include "ast_optimizer.h"
+#include "parser.h"
+#include "factory.h"
+#include "context.h"
+#include "jsast.h"
+#include "jsval.h"
+#include "jsstring.h"
+#include "jsscript.h"
+#include "icu/ustream.h"
+#include "icu/source.h"
+namespace iv {
+namespace lv5 {
+namespace test {
+
+inline std::string ToStdString(Context* ctx, const JSVal& val) {
+  const JSString* const str = val.ToString(ctx, ctx->error());
+  if (ctx->IsError()) {
+    ctx->error()->Clear();
+    return "<STRING CONVERSION FAILED>";
+  }
+  std::ostringstream out;
+  out << *str;
+  return out.str();
+}
+
+// returns completion value or thrown error of script as string
+inline std::string RunScript(Context* ctx, JSScript* script) {
+  if (ctx->Run(script)) {
+    const JSVal e = ctx->ErrorVal();
+    ctx->error()->Clear();
+    return ToStdString(ctx, e);
+  }
+  return ToStdString(ctx, ctx->ret());
+}
+
+// parse, optimize and run str in ctx as lv5 does,
+// returns completion value or thrown error as string
+inline std::string Evaluate(Context* ctx, const std::string& str) {
+  std::tr1::shared_ptr<icu::Source> src(new icu::Source(str, "test"));
+  AstFactory* const factory = new AstFactory(ctx);
+  core::Parser<AstFactory, icu::Source> parser(factory, src.get());
+  FunctionLiteral* const global = parser.ParseProgram();
+  if (!global) {
+    delete factory;
+    return parser.error();
+  }
+  core::ast::AstOptimizer<AstFactory> optimizer(factory);
+  optimizer.Optimize(global);
+  return RunScript(ctx,
+                   JSEvalScript<icu::Source>::New(ctx, global, factory, src));
+}
+
+} } }  // namespace iv::lv5::test
+#endif  // _IV_TEST_LV5_TEST_LV5_H_
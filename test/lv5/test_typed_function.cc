@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "jstyped_function.h"
+#include "test_lv5.h"
+
+using iv::lv5::test::Evaluate;
+
+namespace {
+
+double Add(double x, double y) {
+  return x + y;
+}
+
+int32_t Truncate(int32_t x) {
+  return x;
+}
+
+bool Not(bool x) {
+  return !x;
+}
+
+iv::lv5::JSString* Twice(iv::lv5::Context* ctx, iv::lv5::JSString* str) {
+  iv::core::UString res(str->data(), str->size());
+  res.append(str->data(), str->size());
+  return iv::lv5::JSString::New(ctx, res);
+}
+
+iv::lv5::JSVal Identity(iv::lv5::JSVal val) {
+  return val;
+}
+
+int count = 0;
+
+void Count() {
+  ++count;
+}
+
+}  // namespace anonymous
+
+TEST(JSTypedFunctionCase, ConversionTest) {
+  iv::lv5::Context ctx;
+  ctx.DefineTypedFunction(&Add, "add");
+  ctx.DefineTypedFunction(&Truncate, "truncate");
+  ctx.DefineTypedFunction(&Not, "not");
+  ctx.DefineTypedFunction(&Twice, "twice");
+  ctx.DefineTypedFunction(&Identity, "identity");
+  EXPECT_EQ("3", Evaluate(&ctx, "add(1, 2);"));
+  EXPECT_EQ("NaN", Evaluate(&ctx, "add(1);"));
+  EXPECT_EQ("3", Evaluate(&ctx, "add('1', 2);"));
+  EXPECT_EQ("-1", Evaluate(&ctx, "truncate(4294967295);"));
+  EXPECT_EQ("true", Evaluate(&ctx, "not(0);"));
+  EXPECT_EQ("false", Evaluate(&ctx, "not('a');"));
+  EXPECT_EQ("boolean", Evaluate(&ctx, "typeof not(1);"));
+  EXPECT_EQ("abab", Evaluate(&ctx, "twice('ab');"));
+  EXPECT_EQ("null", Evaluate(&ctx, "String(identity(null));"));
+}
+
+TEST(JSTypedFunctionCase, LengthTest) {
+  iv::lv5::Context ctx;
+  ctx.DefineTypedFunction(&Add, "add");
+  ctx.DefineTypedFunction(&Twice, "twice");
+  ctx.DefineTypedFunction(&Count, "count");
+  EXPECT_EQ("2", Evaluate(&ctx, "add.length;"));
+  // Context* does not consume an argument
+  EXPECT_EQ("1", Evaluate(&ctx, "twice.length;"));
+  EXPECT_EQ("0", Evaluate(&ctx, "count.length;"));
+  count = 0;
+  EXPECT_EQ("undefined", Evaluate(&ctx, "String(count());"));
+  EXPECT_EQ(1, count);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include "alloc.h"
+
+namespace {
+
+class CountingAllocator {
+ public:
+  static void* New(std::size_t size) {
+    ++count;
+    return std::malloc(size);
+  }
+  static void Delete(void* p) {
+    --count;
+    std::free(p);
+  }
+  static int count;
+};
+
+int CountingAllocator::count = 0;
+
+}  // namespace anonymous
+
+TEST(SpaceCase, AlignmentTest) {
+  iv::core::Space<1> space;
+  for (std::size_t i = 1; i < 300; ++i) {
+    void* ptr = space.New(i);
+    ASSERT_TRUE(ptr != NULL);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % 8);
+  }
+}
+
+TEST(SpaceCase, ClearReuseTest) {
+  iv::core::Space<1> space;
+  void* const first = space.New(16);
+  for (std::size_t i = 0; i < 100000; ++i) {
+    space.New(32);
+  }
+  space.Clear();
+  EXPECT_EQ(first, space.New(16));
+}
+
+TEST(SpaceCase, UpstreamTest) {
+  ASSERT_EQ(0, CountingAllocator::count);
+  {
+    iv::core::Space<1, CountingAllocator> space;
+    // fills inline arena and grows
+    for (std::size_t i = 0; i < 100000; ++i) {
+      space.New(32);
+    }
+    const int chunks = CountingAllocator::count;
+    EXPECT_LT(0, chunks);
+    const std::size_t size = space.upstream_size();
+    EXPECT_LT(0u, size);
+
+    // large objects are dedicated chunks
+    space.New(1024);
+    space.New(iv::core::Size::KB * 64);
+    EXPECT_EQ(chunks + 2, CountingAllocator::count);
+    EXPECT_EQ(size + 1024 + iv::core::Size::KB * 64, space.upstream_size());
+
+    // Clear releases large objects and keeps chunks
+    space.Clear();
+    EXPECT_EQ(chunks, CountingAllocator::count);
+    EXPECT_EQ(size, space.upstream_size());
+    for (std::size_t i = 0; i < 100000; ++i) {
+      space.New(32);
+    }
+    EXPECT_EQ(chunks, CountingAllocator::count);
+  }
+  EXPECT_EQ(0, CountingAllocator::count);
+}
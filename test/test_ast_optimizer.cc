@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "alloc.h"
+#include "ast.h"
+#include "ast_factory.h"
+#include "ast_optimizer.h"
+#include "ast_serializer.h"
+#include "parser.h"
+#include "ustring.h"
+#include "icu/source.h"
+
+namespace {
+
+class Factory
+  : public iv::core::Space<2>,
+    public iv::core::ast::BasicAstFactory<Factory> {
+ public:
+  Factory()
+    : iv::core::Space<2>(),
+      iv::core::ast::BasicAstFactory<Factory>() {
+  }
+};
+
+typedef iv::core::ast::FunctionLiteral<Factory> FunctionLiteral;
+typedef iv::core::ast::Statement<Factory> Statement;
+
+FunctionLiteral* Parse(Factory* factory,
+                       const iv::icu::Source* src, bool optimize) {
+  iv::core::Parser<Factory, iv::icu::Source> parser(factory, src);
+  FunctionLiteral* const global = parser.ParseProgram();
+  EXPECT_TRUE(global) << parser.error();
+  if (global && optimize) {
+    iv::core::ast::AstOptimizer<Factory> optimizer(factory);
+    optimizer.Optimize(global);
+  }
+  return global;
+}
+
+std::string Serialize(const std::string& str, bool optimize = true) {
+  Factory factory;
+  const iv::icu::Source src(str, "test");
+  const FunctionLiteral* const global = Parse(&factory, &src, optimize);
+  if (!global) {
+    return std::string();
+  }
+  iv::core::ast::AstSerializer<Factory> ser;
+  global->Accept(&ser);
+  const iv::core::UString& out = ser.out();
+  return std::string(out.begin(), out.end());
+}
+
+// optimized str1 is the same tree as parsed str2
+void ExpectOptimized(const std::string& str1, const std::string& str2) {
+  EXPECT_EQ(Serialize(str2, false), Serialize(str1)) << str1;
+}
+
+}  // namespace anonymous
+
+TEST(AstOptimizerCase, NumberFoldingTest) {
+  ExpectOptimized("1 + 2 * 3;", "7;");
+  ExpectOptimized("10 - 4 / 2;", "8;");
+  ExpectOptimized("7 % 4;", "3;");
+  ExpectOptimized("1 < 2;", "true;");
+  ExpectOptimized("2 <= 1;", "false;");
+  ExpectOptimized("1 === 1;", "true;");
+  ExpectOptimized("1 != 1;", "false;");
+  ExpectOptimized("x + 1 + 2;", "x + 1 + 2;");
+}
+
+TEST(AstOptimizerCase, StringFoldingTest) {
+  ExpectOptimized("'a' + 'b';", "'ab';");
+  ExpectOptimized("'a' + 1;", "'a1';");
+  ExpectOptimized("0.5 + 'a';", "'0.5a';");
+  ExpectOptimized("'a' < 'b';", "true;");
+  ExpectOptimized("'a' == 'b';", "false;");
+  ExpectOptimized("'a' + x;", "'a' + x;");
+}
+
+TEST(AstOptimizerCase, UnaryFoldingTest) {
+  ExpectOptimized("!0;", "true;");
+  ExpectOptimized("x = !'a';", "x = false;");
+  ExpectOptimized("typeof 1;", "'number';");
+  ExpectOptimized("typeof 'a';", "'string';");
+  ExpectOptimized("typeof null;", "'object';");
+  ExpectOptimized("typeof x;", "typeof x;");
+}
+
+TEST(AstOptimizerCase, LogicalFoldingTest) {
+  ExpectOptimized("true && x;", "x;");
+  ExpectOptimized("0 && x;", "0;");
+  ExpectOptimized("y = '' || x;", "y = x;");
+  ExpectOptimized("1 || x;", "1;");
+  ExpectOptimized("1 ? x : y;", "x;");
+  ExpectOptimized("null ? x : y;", "y;");
+  ExpectOptimized("x && true;", "x && true;");
+}
+
+TEST(AstOptimizerCase, ReferenceTest) {
+  // (true && o.m) is not a Reference, so this is not bound to o
+  ExpectOptimized("(true && o.m)();", "(true && o.m)();");
+  EXPECT_NE(Serialize("o.m();", false), Serialize("(true && o.m)();"));
+  // operands of the target are still folded
+  ExpectOptimized("(1 + 2 && o.m)();", "(3 && o.m)();");
+  ExpectOptimized("o[1 + 2]();", "o[3]();");
+  ExpectOptimized("typeof (true && x);", "typeof (true && x);");
+}
+
+TEST(AstOptimizerCase, DeadBranchTest) {
+  ExpectOptimized("if (1) { x(); } else { y(); }", "{ x(); }");
+  ExpectOptimized("if (0) { x(); } else { y(); }", "{ y(); }");
+  ExpectOptimized("if (0) { x(); }", ";");
+  ExpectOptimized("while (false) { x(); }", ";");
+  ExpectOptimized("if (x) { y(); }", "if (x) { y(); }");
+}
+
+TEST(AstOptimizerCase, DeadStatementTest) {
+  ExpectOptimized("function f() { return 1; x(); y(); }",
+                  "function f() { return 1; }");
+  ExpectOptimized("function f() { throw 1; x(); }",
+                  "function f() { throw 1; }");
+  ExpectOptimized("for (;;) { break; x(); }",
+                  "for (;;) { break; }");
+  ExpectOptimized("for (;;) { continue; x(); }",
+                  "for (;;) { continue; }");
+}
+
+TEST(AstOptimizerCase, HoistingTest) {
+  // declarations after return are removed from body,
+  // but still declared in function scope
+  Factory factory;
+  const iv::icu::Source src(
+      "function f() { return g; var x = 1; function g() { } }", "test");
+  FunctionLiteral* const global = Parse(&factory, &src, true);
+  ASSERT_TRUE(global);
+  ASSERT_EQ(1u, global->body().size());
+  Statement* const stmt = global->body().front();
+  ASSERT_TRUE(stmt->AsFunctionDeclaration());
+  const FunctionLiteral* const f = stmt->AsFunctionDeclaration()->function();
+  ASSERT_EQ(1u, f->body().size());
+  EXPECT_TRUE(f->body().front()->AsReturnStatement());
+  ASSERT_EQ(1u, f->scope().variables().size());
+  const iv::core::UStringPiece x =
+      f->scope().variables().front().first->value();
+  EXPECT_EQ(std::string("x"), std::string(x.begin(), x.end()));
+  ASSERT_EQ(1u, f->scope().function_declarations().size());
+  const iv::core::UStringPiece g =
+      f->scope().function_declarations().front()->name()->value();
+  EXPECT_EQ(std::string("g"), std::string(g.begin(), g.end()));
+}
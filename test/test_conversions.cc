@@ -114,3 +114,35 @@ TEST(ConversionsCase, StringToIntegerWithRadix) {
   ASSERT_EQ(StringToIntegerWithRadix("go", 36, true), 600);
   ASSERT_TRUE(std::isnan(StringToIntegerWithRadix("20dddd", 2, true)));
 }
+
+TEST(ConversionsCase, ConvertToUInt32Test) {
+  using iv::core::ConvertToUInt32;
+  using iv::core::UStringPiece;
+  const iv::uc16 zero[] = { '0' };
+  const iv::uc16 one[] = { '1' };
+  const iv::uc16 leading_zero[] = { '0', '1' };
+  const iv::uc16 ten[] = { '1', '0' };
+  const iv::uc16 sign[] = { '+', '1' };
+  const iv::uc16 alpha[] = { '1', 'a' };
+  const iv::uc16 max[] = {
+    '4', '2', '9', '4', '9', '6', '7', '2', '9', '4' };
+  const iv::uc16 over[] = {
+    '4', '2', '9', '4', '9', '6', '7', '2', '9', '5' };
+  const iv::uc16 wide[] = {
+    '1', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0' };
+  uint32_t value;
+  ASSERT_TRUE(ConvertToUInt32(UStringPiece(zero, 1), &value));
+  EXPECT_EQ(0u, value);
+  ASSERT_TRUE(ConvertToUInt32(UStringPiece(one, 1), &value));
+  EXPECT_EQ(1u, value);
+  ASSERT_TRUE(ConvertToUInt32(UStringPiece(ten, 2), &value));
+  EXPECT_EQ(10u, value);
+  ASSERT_TRUE(ConvertToUInt32(UStringPiece(max, 10), &value));
+  EXPECT_EQ(4294967294u, value);
+  EXPECT_FALSE(ConvertToUInt32(UStringPiece(), &value));
+  EXPECT_FALSE(ConvertToUInt32(UStringPiece(leading_zero, 2), &value));
+  EXPECT_FALSE(ConvertToUInt32(UStringPiece(sign, 2), &value));
+  EXPECT_FALSE(ConvertToUInt32(UStringPiece(alpha, 2), &value));
+  EXPECT_FALSE(ConvertToUInt32(UStringPiece(over, 10), &value));
+  EXPECT_FALSE(ConvertToUInt32(UStringPiece(wide, 11), &value));
+}
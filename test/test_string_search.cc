@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <algorithm>
+#include "uchar.h"
+#include "xorshift.h"
+#include "string_search.h"
+
+namespace {
+
+template<typename String>
+std::size_t NaiveSearch(const String& subject,
+                        const String& pattern, std::size_t start) {
+  for (std::size_t pos = start;
+       pos <= subject.size() && subject.size() - pos >= pattern.size();
+       ++pos) {
+    if (std::equal(pattern.begin(), pattern.end(), subject.begin() + pos)) {
+      return pos;
+    }
+  }
+  return iv::core::StringSearch<typename String::value_type>::npos;
+}
+
+template<typename String>
+std::size_t NaiveReverseSearch(const String& subject,
+                               const String& pattern, std::size_t start) {
+  if (subject.size() < pattern.size()) {
+    return iv::core::StringSearch<typename String::value_type>::npos;
+  }
+  for (std::size_t pos = std::min(start, subject.size() - pattern.size());
+       ; --pos) {
+    if (std::equal(pattern.begin(), pattern.end(), subject.begin() + pos)) {
+      return pos;
+    }
+    if (pos == 0) {
+      return iv::core::StringSearch<typename String::value_type>::npos;
+    }
+  }
+}
+
+// checks Search and ReverseSearch from every start position
+template<typename String>
+void ExpectSameAsNaive(const String& subject, const String& pattern) {
+  typedef iv::core::StringSearch<typename String::value_type> Searcher;
+  const Searcher searcher(pattern.data(), pattern.size());
+  for (std::size_t start = 0; start <= subject.size() + 1; ++start) {
+    EXPECT_EQ(NaiveSearch(subject, pattern, start),
+              searcher.Search(subject.data(), subject.size(), start))
+        << "search " << start;
+    EXPECT_EQ(NaiveReverseSearch(subject, pattern, start),
+              searcher.ReverseSearch(subject.data(), subject.size(), start))
+        << "reverse search " << start;
+  }
+  EXPECT_EQ(NaiveReverseSearch(subject, pattern, Searcher::npos),
+            searcher.ReverseSearch(subject.data(), subject.size()));
+}
+
+std::string Repeat(const std::string& str, std::size_t n) {
+  std::string res;
+  for (std::size_t i = 0; i < n; ++i) {
+    res.append(str);
+  }
+  return res;
+}
+
+}  // namespace anonymous
+
+TEST(StringSearchCase, EmptyTest) {
+  ExpectSameAsNaive(std::string(), std::string());
+  ExpectSameAsNaive(std::string("abc"), std::string());
+  ExpectSameAsNaive(std::string(), std::string("a"));
+  ExpectSameAsNaive(std::string(), std::string("abcdefghij"));
+}
+
+TEST(StringSearchCase, OneCharTest) {
+  ExpectSameAsNaive(std::string("a"), std::string("a"));
+  ExpectSameAsNaive(std::string("b"), std::string("a"));
+  ExpectSameAsNaive(std::string("abcabc"), std::string("c"));
+  ExpectSameAsNaive(std::string("abcabc"), std::string("d"));
+}
+
+TEST(StringSearchCase, ShortPatternTest) {
+  ExpectSameAsNaive(std::string("abcabcabd"), std::string("abd"));
+  ExpectSameAsNaive(std::string("aaaaaaa"), std::string("aaa"));
+  ExpectSameAsNaive(std::string("ab"), std::string("abc"));
+  ExpectSameAsNaive(std::string("the quick brown fox"), std::string("fox"));
+}
+
+TEST(StringSearchCase, HorspoolTest) {
+  const std::string subject("the quick brown fox jumps over the lazy dog");
+  ExpectSameAsNaive(subject, std::string("jumps over"));
+  ExpectSameAsNaive(subject, std::string("the lazy dog"));
+  ExpectSameAsNaive(subject, std::string("the quick"));
+  ExpectSameAsNaive(subject, std::string("the lazy cat"));
+  ExpectSameAsNaive(subject + subject, subject);
+}
+
+TEST(StringSearchCase, TwoWayFallbackTest) {
+  // every alignment compares the whole run of 'a' before mismatch,
+  // so Horspool runs out of its budget and continues by Two-Way
+  const std::string run = Repeat("a", 16);
+  ExpectSameAsNaive(Repeat("a", 1000), run + "b" + run);
+  ExpectSameAsNaive(Repeat("a", 1000) + "b" + run, run + "b" + run);
+  ExpectSameAsNaive(Repeat("a", 500) + "b" + Repeat("a", 500), run + "b" + run);
+  // periodic pattern
+  ExpectSameAsNaive(Repeat("ab", 500), Repeat("ab", 20) + "b");
+  ExpectSameAsNaive(Repeat("ab", 500) + "b", Repeat("ab", 20) + "b");
+  ExpectSameAsNaive(Repeat("aab", 300) + "aaab", Repeat("aab", 10) + "aaab");
+}
+
+TEST(StringSearchCase, RandomTest) {
+  // small alphabet makes many partial matches
+  iv::core::Xor128 gen;
+  for (std::size_t n = 0; n < 200; ++n) {
+    std::string subject;
+    const std::size_t subject_size = gen() % 300;
+    for (std::size_t i = 0; i < subject_size; ++i) {
+      subject.push_back('a' + gen() % 2);
+    }
+    std::string pattern;
+    const std::size_t pattern_size = gen() % 24;
+    for (std::size_t i = 0; i < pattern_size; ++i) {
+      pattern.push_back('a' + gen() % 2);
+    }
+    ExpectSameAsNaive(subject, pattern);
+    if (subject_size > pattern_size) {
+      // pattern which surely appears
+      const std::size_t pos = gen() % (subject_size - pattern_size);
+      ExpectSameAsNaive(subject, subject.substr(pos, pattern_size));
+    }
+  }
+}
+
+TEST(StringSearchCase, UCharTest) {
+  typedef std::basic_string<iv::uc16> ustring;
+  // 0x0161 and 0x0061 have the same lower 8 bits,
+  // so they share one entry of the Horspool table
+  const iv::uc16 a = 0x0061;
+  const iv::uc16 b = 0x0161;
+  ustring subject(1000, a);
+  subject[300] = b;
+  subject[700] = b;
+  ustring pattern(16, a);
+  pattern[8] = b;
+  ExpectSameAsNaive(subject, pattern);
+  ExpectSameAsNaive(subject, ustring(1, b));
+  ExpectSameAsNaive(subject, ustring(10, a));
+  subject[308] = b;
+  ExpectSameAsNaive(subject, pattern);
+}
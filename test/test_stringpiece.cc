@@ -68,3 +68,14 @@ TEST(StringPieceCase, EqualTest) {
   EXPECT_NE(StringPiece(string("OKK")), StringPiece(string("OK")));
   EXPECT_NE(StringPiece("OKK"), StringPiece("OK"));
 }
+
+TEST(StringPieceCase, UStringCompareTest) {
+  const UChar eval[] = { 'e', 'v', 'a', 'l', 0 };
+  const UChar evil[] = { 'e', 'v', 'i', 'l', 0 };
+  const UChar e100[] = { 'e', 0x100, 0 };
+  const UChar e001[] = { 'e', 0x001, 0 };
+  EXPECT_EQ(UStringPiece(eval), UStringPiece(eval));
+  EXPECT_NE(UStringPiece(eval), UStringPiece(evil));
+  EXPECT_LT(UStringPiece(eval), UStringPiece(evil));
+  EXPECT_LT(UStringPiece(e001), UStringPiece(e100));
+}